@@ -0,0 +1,51 @@
+#include "Plan.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/* Time of one real FFT of every backend of spectrum::Plan 
+ * for NFFT from 64 to 65536, the best of several runs
+ *
+ * Usage: spectrumBenchmark [repetitions] */
+
+/* Transforms timed together, enough for the clock */
+#define BENCH_TRANSFORMS 64
+
+static double measure(spectrum::Backend backend, int NFFT, int repetitions) {
+    spectrum::Plan plan(NFFT, backend);
+    std::vector<float> samples(NFFT);
+    std::vector<kiss_fft_cpx> spectrum(NFFT / 2 + 1);
+    
+    for (int i = 0; i < NFFT; i++)
+        samples[i] = (float)std::rand() / RAND_MAX - 0.5f;
+    
+    /* Every repetition runs the transforms enough times to be measured, 
+     * the fastest one is kept (the least disturbed by the system) */
+    const int transforms = std::max(1, BENCH_TRANSFORMS * 65536 / NFFT);
+    double best = 1e30;
+    
+    for (int r = 0; r < repetitions; r++) {
+        const auto beg = std::chrono::steady_clock::now();
+        for (int t = 0; t < transforms; t++)
+            plan.fftr(samples.data(), spectrum.data());
+        const auto end = std::chrono::steady_clock::now();
+        
+        best = std::min(best, std::chrono::duration<double, std::micro>(end - beg).count() 
+                              / transforms);
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const int repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+    
+    std::printf("%8s %12s %12s\n", "NFFT", "kissfft", "Stockham");
+    for (int NFFT = 64; NFFT <= 65536; NFFT *= 2) {
+        std::printf("%8d %9.2f us %9.2f us\n", NFFT, 
+                    measure(spectrum::KISSFFT, NFFT, repetitions), 
+                    measure(spectrum::STOCKHAM, NFFT, repetitions));
+    }
+    return 0;
+}
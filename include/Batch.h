@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Processing.h"
+#include "WorkPool.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace spectrum {
+
+/* Analysis of many audio files by a pool of worker threads
+ *
+ * The calling thread only reads the files into memory, one after the other, 
+ * a few files ahead of the workers (see spectrum::WorkPool), 
+ * so reading the next files overlaps the work on the current ones 
+ *
+ * Every file is decoded and analyzed by a worker, by pFFT(timeScale) 
+ * of a spectrum::BasicProcessing, the plans are kept by each worker thread 
+ * and reused for all its files (see spectrum::BasicPlan::getShared)
+ *
+ * T is the type of the frames and of the FFT, float or double */
+template<typename T>
+class BasicBatch {
+
+public:
+    /* The results of a file: its index in the list, its path, 
+     * the object after pFFT(timeScale) (getpfftValues() and the other methods) 
+     *
+     * Called by the worker threads, concurrently for different files */
+    typedef std::function<void(int index, const std::string& path, 
+                               BasicProcessing<T>& processing)> callback_t;
+
+    /* The analysis of every file: NFFT, timeScale and backend as of 
+     * spectrum::Processing, threads - number of workers, 
+     * 0 - one per hardware thread */
+    BasicBatch(int NFFT, int timeScale, Backend backend = KISSFFT, int threads = 0);
+    ~BasicBatch();
+
+    /* Analyzing the files of paths, callback receives the results of each one, 
+     * returns when all of them are done
+     *
+     * A file that cannot be read has no frames and no spectrum
+     * (getFramesPerChannel() is 0) */
+    void run(const std::vector<std::string>& paths, callback_t callback);
+
+private:
+    const int NFFT;
+    const int timeScale;
+    const Backend backend;
+
+    WorkPool pool;
+
+    /* Files read and not yet decoded, at most 2 per worker */
+    std::mutex mutex;
+    std::condition_variable decoded;
+    int ahead;
+};
+
+/* Batch analysis in single precision (spectrum::Processing) */
+typedef BasicBatch<float> Batch;
+}
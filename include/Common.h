@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+#define EMPTY_CONTAINER "An empty container of the audio file spectrum, you did FFT or pFFT?\nYou may have called the wrong FFT Spectrum return method" 
+#define BAD_ALLOCATE "Memory resources cannot be allocated"
+#define BAD_NFFT "A number meaning size of the FFT window must be even and greater than 0"
+#define BAD_TIMESCALE "The entered time scaling ratio should not be less than 1 or more than 1000"
+#define BAD_CHANNEL "The requested channel does not match the available channels of the audio file" 
+#define BAD_PCM "The audio file cannot be read as an integer PCM WAV file"
+#define BAD_HOP "The hop must be from 1 to the FFT window size"
+#define BAD_BAND "The band must be 0 <= fmin < fmax <= the half of the sample rate, with a resolution greater than 0"
+#define BAD_BINS "The number of bins per octave must be greater than 0"
+#define BAD_FILTERS "The number of mel filters must be greater than 0 and not less than the number of coefficients, which must be greater than 0"
+#define BAD_FACTOR "The decimation factor must be greater than 0 and divide the sample rate of the audio file"
+#define BAD_RATE "The sample rate must be greater than 0"
+#define BAD_TAPS "The FIR filter must have at least one tap"
+#define BAD_SPECTRA "The spectra must be FFT of NFFT frames of the channels of the audio file"
+#define BAD_SHARED "The objects must share the frames of the same audio file"
+#define BAD_CHANNELS "The number of channels must be greater than 0"
+#define BAD_FREQUENCY "The requested frequency must be from 0 to the half of the sample rate of the audio file"
+
+namespace spectrum {
+
+/* A structure containing FFT data */
+template <typename v, typename sV>
+struct Keepeth {
+    typedef v values_t;
+    typedef sV scaledValues_t;
+
+    /* The channel to which the conversion refers */
+    int channel;
+    /* The number of frequencies per spectral component */
+    float freqPerBin;
+    /* The time point for which the FFT was made */
+    float time;
+    /* The frequency of the first spectral component, 
+     * 0 unless the spectrum is limited to a band */
+    float firstFreq;
+    /* The first frame of the audio file channel in the FFT window */
+    int frame;
+    /* The number of spectral components in values and scaledValues */
+    int bins;
+    /* Non-normalized FFT values for the current time moment 
+     * that contain the kiss_fft_cpx structure:
+     * r - the real part of the spectrum, 
+     * i - the imaginary part of the spectrum */
+    v values;
+    /* Normalized FFT values for the current time moment */
+    sV scaledValues;  
+        
+    Keepeth(int ch, float fpb, float t, v vls, sV sVls, float ff = 0, int fr = 0, 
+            int bs = 0)
+        : channel(ch),
+        freqPerBin(fpb),
+        time(t),
+        firstFreq(ff),
+        frame(fr),
+        bins(bs),
+        /* Transfer of ownership of the pointer in the initializer (std::move) */
+        values(std::move(vls)),
+        scaledValues(std::move(sVls)) {};
+};
+
+/* Copies the entries [beg, end) of s, which keep the FFT data in arrays, 
+ * to a container of entries keeping it in std::vector, each entry 
+ * copies its own number of bins (they differ between the calls 
+ * limited to a band) 
+ * channel - only the entries of this channel, -1 for every channel */
+template <typename R, typename S>
+R peekValues(const S& s, const int beg, const int end, const int channel = -1) {
+    typedef typename R::value_type entry_t;
+    R r;
+
+    for (int i = beg; i < end; i++) {
+        if (channel >= 0 && s[i].channel != channel)
+            continue;
+        
+        r.push_back(entry_t(s[i].channel, 
+                            s[i].freqPerBin, 
+                            s[i].time, 
+                            typename entry_t::values_t(s[i].values.get(), 
+                                                       s[i].values.get() + s[i].bins), 
+                            typename entry_t::scaledValues_t(s[i].scaledValues.get(), 
+                                                             s[i].scaledValues.get() + s[i].bins), 
+                            s[i].firstFreq, 
+                            s[i].frame, 
+                            s[i].bins));
+    }
+
+    return r;
+};
+
+/* Dynamic range
+ * With a bit depth of 16 bits from 32767 to -32768 (65536)
+ * Is equal to 96.33Db
+ * Used to normalize the FFT values (see scaleValue()) */
+template <typename T>
+T dynamicRange(const int bitDepth) {
+    return std::abs(20 * std::log10(1 / (T)std::pow(2, bitDepth)));
+};
+
+/* FFT normalization to db
+ *                  x = sqrt(r^2 +i^2)
+ * Distance between two points (Euclidean distance) 
+ * calculated by Pythagorean theorem
+ * 
+ * We use the standard transformation - 20 * log10(x)
+ * 
+ * Then we sum the resulting number with the number 
+ * mean the dynamic range (for the current "depth" of quantization)
+ * 
+ * Now the maximum amplitude is 0 = -96.33 + 96.33
+ * 
+ * Then divide by the same number, bringing all values from -inf to 1.0f, multiply by 100 */
+template <typename T>
+T scaleValue(const T r, const T i, const T dynamicRange) {
+    return (((20 * std::log10(std::sqrt(r * r + i * i)) + (-1 * dynamicRange)) / dynamicRange)) * 100;
+};
+
+/* Terminate program with exitMessage */
+void terminate(const char* exitMessage);
+}
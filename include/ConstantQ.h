@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Plan.h"
+#include <memory>
+#include <vector>
+
+namespace spectrum {
+
+/* Constant-Q transform of a real signal by spectral kernels (Brown - Puckette)
+ *
+ * The bins are log-spaced, binsPerOctave per octave from fmin:
+ * f[k] = fmin * 2^(k / binsPerOctave), each one with the same 
+ * ratio Q of frequency to bandwidth, Q = 1 / (2^(1 / binsPerOctave) - 1)
+ *
+ * The temporal kernel of a bin is a Hamming windowed complex sinusoid 
+ * of Q periods, the spectral kernel is its FFT: it is concentrated 
+ * around f[k], so only the FFT bins above a threshold are kept 
+ * (the first bin and the weights). A frame costs one real FFT 
+ * of NFFT samples and a few products per constant-Q bin
+ *
+ * The kernels of a (sampleRate, binsPerOctave, fmin, fmax) 
+ * are computed once and shared by all the objects, the ones 
+ * of the last few parameters are kept for the next objects
+ *
+ * T is the type of the samples and of the values, float or double */
+template<typename T>
+class ConstantQ {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    ConstantQ(int sampleRate, float fmin, float fmax, int binsPerOctave);
+    ~ConstantQ();
+
+    /* false if the memory resources of the FFTs cannot be allocated */
+    bool isValid();
+
+    /* FFT window size, the length of the kernel of fmin 
+     * rounded up to a power of 2 */
+    int getNFFT();
+
+    /* Number of constant-Q bins, K */
+    int getSize();
+
+    /* Centre frequency of the k-th bin */
+    float getFrequency(int k);
+
+    /* Performing the constant-Q transform of NFFT samples
+     * 
+     * values receives K values */
+    void transform(const T* samples, cpx_t* values);
+
+private:
+    /* Sparse spectral kernels of all the bins */
+    struct Kernel {
+        int NFFT;
+        std::vector<float> frequencies;
+        /* The first FFT bin of the kernel of the k-th bin */
+        std::vector<int> start;
+        /* Weights of the k-th bin: weights[offset[k]] to weights[offset[k + 1]],
+         * conjugated and divided by NFFT */
+        std::vector<int> offset;
+        std::vector<cpx_t> weights;
+    };
+
+    std::shared_ptr<const Kernel> kernel;
+
+    BasicPlan<T> plan;
+
+    /* FFT of the frame */
+    std::vector<cpx_t> freq;
+
+    /* The kernels of the parameters, computed on the first request 
+     * or when they are no longer cached */
+    static std::shared_ptr<const Kernel> _kernel(int sampleRate, float fmin, 
+                                                 float fmax, int binsPerOctave);
+};
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Plan.h"
+#include <vector>
+
+namespace spectrum {
+
+/* Time delays between the channels of a frame by FFT cross-correlation
+ *
+ * For the pair of channels (a, b) the cross-spectrum conj(Xa) * Xb 
+ * of their spectra is transformed back: the correlation 
+ * r[t] = sum of xa[n] * xb[n + t] is at its largest for the delay of b 
+ * after a, in O(NFFT log NFFT) instead of O(NFFT^2) 
+ *
+ * The product of two spectra of NFFT points is the circular correlation, 
+ * the lags t and t - NFFT are summed: the frames of every channel 
+ * are recovered by the inverse FFT and zero padded to 2 * NFFT, 
+ * so r[t] is the linear correlation for all the lags |t| < NFFT
+ *
+ * GCC-PHAT (phase transform) divides the cross-spectrum by its magnitude, 
+ * only the phases are kept, the peak is sharp whatever the spectra 
+ * of the sources and the reverberation 
+ *
+ * The peak is refined between the lags by a parabola through 
+ * the largest value and its neighbours
+ *
+ * The pairs are (0, 1), (0, 2) ... (0, C - 1), (1, 2) ... (C - 2, C - 1)
+ *
+ * T is the type of the spectrum values, float or double */
+template<typename T>
+class CrossCorrelation {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* maxLag - the largest delay searched in frames, up to NFFT - 1, 
+     * 0 - the half of the window, NFFT / 2 - 1 */
+    CrossCorrelation(int NFFT, int channels, bool phat = true, int maxLag = 0);
+    ~CrossCorrelation();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* Number of pairs of channels, C * (C - 1) / 2 */
+    int getPairs();
+
+    /* The largest delay searched in frames */
+    int getMaxLag();
+
+    /* Delays of all the pairs of the frame 
+     *
+     * spectra[c] - NFFT / 2 + 1 spectrum values of the c-th channel, 
+     * lags receives getPairs() delays in frames, positive if 
+     * the second channel of the pair comes after the first one */
+    void delays(const cpx_t* const* spectra, T* lags);
+
+private:
+    const int NFFT;
+    const bool phat;
+    const int maxLag;
+
+    /* The channels of the p-th pair */
+    std::vector<int> first;
+    std::vector<int> second;
+
+    /* The FFT of the frames and the one of 2 * NFFT points */
+    BasicPlan<T> plan;
+    BasicPlan<T> padded;
+
+    /* The frames of a channel zero padded to 2 * NFFT */
+    std::vector<T> frames;
+
+    /* The spectra of 2 * NFFT points of the channels, [c * (NFFT + 1) + k] */
+    std::vector<cpx_t> spectra;
+
+    /* The cross-spectrum and the correlation of a pair */
+    std::vector<cpx_t> cross;
+    std::vector<T> correlation;
+};
+}
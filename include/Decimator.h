@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+namespace spectrum {
+
+/* Polyphase anti-alias decimation of a real signal by an integer factor
+ *
+ * The low-pass FIR filter is split into factor phases, 
+ * h[k * factor + p] is the k-th tap of the p-th phase, 
+ * each phase filters the signal subsampled from the frame p, 
+ * so only the kept outputs are computed, 
+ * about getLength() / factor multiplications per input frame
+ *
+ * The outputs are computed by blocks, tap by tap, over contiguous 
+ * frames, the inner loop is a multiply-add by SSE (see Simd.h)
+ *
+ * The stopband of the filter begins at the half of the decimated rate, 
+ * nothing is aliased, the passband goes up to about 0.77 of it 
+ *
+ * T is the type of the samples, float or double */
+template<typename T>
+class Decimator {
+
+public:
+    Decimator(int factor);
+    ~Decimator();
+
+    /* Decimation factor */
+    int getFactor();
+
+    /* Number of taps of the filter */
+    int getLength();
+
+    /* Number of outputs of N input frames */
+    int getSize(int N);
+
+    /* Filtering and decimating N frames, out receives getSize(N) frames, 
+     * the n-th one is centred on the frame n * factor 
+     * (the frames out of the signal are zero) */
+    void process(const T* samples, const int N, T* out);
+
+private:
+    const int factor;
+
+    /* Taps per phase */
+    int K;
+
+    /* Half of the length of the filter, the delay compensated */
+    int half;
+
+    /* Polyphase filter, [p * K + k] - k-th tap of the p-th phase */
+    std::vector<T> bank;
+
+    /* The signal subsampled for each phase, [p * P + i] */
+    std::vector<T> phases;
+};
+}
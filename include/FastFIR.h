@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Plan.h"
+#include <memory>
+#include <vector>
+
+namespace spectrum {
+
+/* FIR filtering by FFT fast convolution, overlap-save 
+ * (the method of kissfft tools/kiss_fastfir.c)
+ *
+ * The signal is cut into blocks of getBlockSize() = NFFT - L + 1 frames, 
+ * each block is transformed with the L - 1 frames before it, multiplied 
+ * by the spectrum of the L taps and transformed back: the last 
+ * getBlockSize() frames of the result are the filtered block,
+ * about log2(NFFT) operations per frame instead of L
+ *
+ * y[n] = sum of taps[k] * x[n - k], the frames before the signal are zero
+ *
+ * The filter is stateful, the signal may be given in chunks of any size, 
+ * chunks of getBlockSize() frames are the cheapest 
+ *
+ * The FFT is the plan of the calling thread (see spectrum::BasicPlan::getShared), 
+ * the filters of a thread share it 
+ *
+ * T is the type of the samples and of the taps, float or double */
+template<typename T>
+class FastFIR {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* NFFT - the FFT size, even and greater than the number of taps, 
+     * 0 - the cheapest power of 2 for the number of taps */
+    FastFIR(const std::vector<T>& taps, int NFFT = 0, Backend backend = KISSFFT);
+    ~FastFIR();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* FFT size */
+    int getNFFT();
+
+    /* Number of taps, L */
+    int getLength();
+
+    /* Number of frames filtered by one FFT, NFFT - L + 1 */
+    int getBlockSize();
+
+    /* Clearing the frames of the previous chunks */
+    void reset();
+
+    /* Filtering the next N frames of the signal, out receives N frames */
+    void process(const T* samples, const int N, T* out);
+
+    /* The cheapest power of 2 FFT size for L taps */
+    static int getCheapestSize(int L);
+
+private:
+    const int L;
+    const int NFFT;
+    const Backend backend;
+
+    /* Spectrum of the taps divided by NFFT */
+    std::vector<cpx_t> kernel;
+
+    /* The L - 1 previous frames followed by the frames of the current block */
+    std::vector<T> buffer;
+
+    /* Number of frames of the current block */
+    int pending;
+
+    /* Spectrum and result of a block */
+    std::vector<cpx_t> freq;
+    std::vector<T> result;
+};
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <complex>
+#include <memory>
+#include <vector>
+
+extern "C" {
+/* kissfft with 16 bit fixed point scalars (src/kiss_fft_i16.c) */
+typedef struct {
+    int16_t r;
+    int16_t i;
+} kiss_fft_i16_cpx;
+
+typedef struct kiss_fftr_i16_state* kiss_fftr_i16_cfg;
+
+kiss_fftr_i16_cfg kiss_fftr_i16_alloc(int nfft, int inverse_fft, void* mem, size_t* lenmem);
+void kiss_fftr_i16(kiss_fftr_i16_cfg cfg, const int16_t* timedata, kiss_fft_i16_cpx* freqdata);
+void kiss_fftri_i16(kiss_fftr_i16_cfg cfg, const kiss_fft_i16_cpx* freqdata, int16_t* timedata);
+}
+
+/* A spectrum value of the 32 bit integer FFT */
+typedef struct {
+    int32_t r;
+    int32_t i;
+} kiss_fft_i32_cpx;
+
+/* kissfft_i32.hh */
+class kissfft_i32;
+
+namespace spectrum {
+
+/* Types of the fixed point FFT of T samples:
+ * cpx_t - a spectrum value, power_t - its power r^2 + i^2 */
+template<typename T>
+struct Fixed;
+
+template<>
+struct Fixed<int16_t> {
+    typedef kiss_fft_i16_cpx cpx_t;
+    typedef int32_t power_t;
+};
+
+template<>
+struct Fixed<int32_t> {
+    typedef kiss_fft_i32_cpx cpx_t;
+    typedef int64_t power_t;
+};
+
+/* A real fixed point FFT of a fixed window size, 
+ * allocated once and reused for every transform
+ *
+ * T is the type of the samples and of the spectrum values:
+ *
+ * int16_t - kissfft with FIXED_POINT=16
+ *
+ * int32_t - kissfft_i32 with twiddle factors in Q30 (products in 64 bit), 
+ * the real signal is transformed as NFFT / 2 complex values
+ *
+ * Every butterfly pass is scaled down to avoid overflow, 
+ * so the spectrum is the one of spectrum::Plan divided by NFFT */
+template<typename T>
+class FixedPlan {
+
+public:
+    typedef typename Fixed<T>::cpx_t cpx_t;
+
+    FixedPlan(int NFFT);
+    ~FixedPlan();
+
+    FixedPlan(const FixedPlan&) = delete;
+    FixedPlan& operator=(const FixedPlan&) = delete;
+
+    /* FFT window size */
+    int getNFFT();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* Performing the FFT of NFFT real samples
+     *
+     * freqdata receives NFFT / 2 + 1 non-normalized spectrum values */
+    void fftr(const T* timedata, cpx_t* freqdata);
+
+private:
+    /* FFT window size */
+    const int NFFT;
+
+    /* Configuration of the 16 bit FFT */
+    kiss_fftr_i16_cfg cfg;
+
+    /* The NFFT / 2 point complex FFT of the 32 bit FFT */
+    std::unique_ptr<kissfft_i32> i32;
+
+    /* Factors combining the complex FFT of the even and odd samples
+     * into the spectrum of the real signal (32 bit FFT, Q30) */
+    std::vector<std::complex<int32_t>> superTwiddles;
+
+    /* Output of the complex FFT (32 bit FFT) */
+    std::vector<std::complex<int32_t>> work;
+};
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "FixedPlan.h"
+#include "PCMFile.h"
+#include "Common.h"
+#include <memory>
+#include <vector>
+
+namespace spectrum {
+
+/* A class representing the fixed point processing of a PCM WAV file:
+ *
+ * the same analysis as spectrum::Processing, but the samples are kept 
+ * as T straight from the data chunk (see spectrum::PCMFile), 
+ * the FFT is a fixed point one (see spectrum::FixedPlan) 
+ * and the spectrum is given as integer power values, 
+ * no floating point arithmetic is done on the signal 
+ *
+ * FixedProcessing<int16_t> - 16 bit files, int32_t power values
+ *
+ * FixedProcessing<int32_t> - 24 and 32 bit files, int64_t power values
+ *
+ * Files of other bit depths are shifted to the width of T */
+template<typename T>
+class FixedProcessing {
+
+public:
+    typedef typename Fixed<T>::cpx_t cpx_t;
+    typedef typename Fixed<T>::power_t power_t;
+
+    /* A data type for public use, the same structure 
+     * as spectrum::Processing::storage_t:
+     *
+     * - std::vector<cpx_t> values - 
+     * FFT values for the current time moment, divided by NFFT 
+     * (kiss_fft_i16_cpx or kiss_fft_i32_cpx)
+     *
+     * - std::vector<power_t> scaledValues - 
+     * power of the FFT values for the current time moment,
+     * r^2 + i^2 (saturated at the maximum of power_t) */
+    typedef std::vector<Keepeth<std::vector<cpx_t>, 
+                                std::vector<power_t>>> storage_t;
+    
+    FixedProcessing(int NFFT, const char* FILE);
+    ~FixedProcessing();
+
+    /* FFT window size */
+    int getNFFT();
+
+    /* The number of frequencies per spectral component
+     * for a given FFT window size */
+    float getFreqPerBin();
+
+    /* Sampling rate of the audio file */
+    int getSampleRate();
+    
+    /* Duration of the audio file in seconds */
+    float getFileDuration();
+
+    /* Number of frames per audio file channel */
+    int getFramesPerChannel();
+
+    /* Total count of frames of the audio file */
+    int getTotalFrames();
+
+    /* Number of channels of the audio file */
+    int getChannels();
+    
+    /* Frame values of each channel of the audio file
+     *  
+     * [i][j] - i-th channel, j-th frame */
+    std::vector<std::vector<T>> getFrames();
+    
+    /* Bit depth of the frame in the audio file */
+    int getBitDepth();
+    
+    bool isMono();
+    
+    /* Output summary data about an object 
+     * and an audio file to the console */
+    void printSummary();
+
+    /* Values of the spectrum of each channel of the total audio file
+     * (see spectrum::FixedProcessing::storage_t) */
+    storage_t getfftValues();
+    
+    /* Values of the spectrum for every time moment 
+     * of every channel of an audio file, the channels 
+     * are contained sequentially (one after the other) */
+    storage_t getpfftValues();
+    
+    /* Spectrum values for each time point of the audio file channel */
+    storage_t getpfftValues(int channel);
+       
+    /* Performing FFT of the first NFFT frames of each channel
+     * (zero padded if the audio file is shorter)
+     * 
+     * After successful execution of the method, allowed:
+     * 
+     * spectrum::FixedProcessing::getfftValues() */
+    void FFT();
+    
+    /* Performing FFT audio file for each time point,
+     * every 1 / timeScale second (see spectrum::Processing::pFFT),
+     * the last windows are zero padded
+     *
+     * After successful execution of the method, allowed:
+     * 
+     * spectrum::FixedProcessing::getpfftValues()
+     * 
+     * spectrum::FixedProcessing::getpfftValues(int channel) */
+    void pFFT(int timeScale /* = 1 */);
+
+private:
+    typedef std::vector<Keepeth<std::unique_ptr<cpx_t[]>, 
+                                std::unique_ptr<power_t[]>>> lstorage_t; 
+     
+    /* FFT window size */
+    const int NFFT;
+
+    /* Path to the audio file */
+    const char* FILE;
+    
+    /* Metadata and samples of the audio file */
+    PCMFile<T> file;
+    
+    /* FFT data for every moment in time, by channels */
+    lstorage_t pstorage;
+    
+    /* FFT data of the total audio file, by channels */
+    lstorage_t storage;
+
+    /* FFT of NFFT frames of the channel beginning at the frame, 
+     * stored in a new element of s */
+    void _transform(FixedPlan<T>& plan, lstorage_t& s, int channel, 
+                    int frame, float time, std::vector<T>& window);
+
+    /* Power of the spectrum, arrays size is NFFT / 2 + 1 */
+    void power(const cpx_t* fft, power_t* power);
+    
+    /* Copies the lstorage_t containing pointers to the FFT data arrays 
+     * to the storage_t in which the FFT data is stored as a std::vector, 
+     * then returns the storage (see spectrum::peekValues)
+     * channel - only the entries of this channel, -1 for every channel */
+    storage_t _peekValues(lstorage_t& s, const int channel = -1);
+};
+}
+std::ostream& operator<<(std::ostream& os, kiss_fft_i16_cpx const& k);
+std::ostream& operator<<(std::ostream& os, kiss_fft_i32_cpx const& k);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+namespace spectrum {
+
+/* Goertzel detector of a few frequencies of a real signal
+ *
+ * Instead of all NFFT / 2 + 1 bins of the FFT, only the magnitudes 
+ * of the target frequencies are computed, O(N * K) for N samples 
+ * and K frequencies: a second order resonator per frequency, 
+ * all of them updated together for each sample
+ *
+ * The frequencies need not be bin centres, the magnitude is 
+ * the one of the DTFT of the samples at the frequency, 
+ * the same scale as the FFT values (sqrt(r^2 + i^2))
+ *
+ * T is the type of the samples, float or double */
+template<typename T>
+class Goertzel {
+
+public:
+    /* frequencies - target frequencies in Hz, from 0 to sampleRate / 2 */
+    Goertzel(const std::vector<float>& frequencies, int sampleRate);
+    ~Goertzel();
+
+    /* Number of target frequencies, K */
+    int getSize();
+
+    /* Magnitudes of the target frequencies in the N samples
+     * 
+     * magnitudes receives K values, in the order of the frequencies */
+    void magnitudes(const T* samples, const int N, T* magnitudes);
+
+private:
+    /* 2 * cos(w) of each frequency */
+    std::vector<T> coefficients;
+
+    /* Resonator states s[n - 1] and s[n - 2] */
+    std::vector<T> s1;
+    std::vector<T> s2;
+};
+}
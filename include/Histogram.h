@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace spectrum {
+
+/* Lock-free histogram of non-negative values, e.g. latencies in nanoseconds
+ *
+ * The values are counted in log-linear buckets: every power of 2 
+ * is split into 32 buckets of the same width, so a percentile 
+ * is known to about 3% of its value over the whole range 
+ * (values below 64 are exact)
+ * 
+ * record() only increments atomic counters, it never allocates, 
+ * locks or waits, the percentiles may be read by another thread 
+ * at the same time, from the values recorded so far */
+class Histogram {
+
+public:
+    Histogram();
+    ~Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /* Adding a value, negative values are counted as 0 */
+    void record(long long value);
+
+    /* Number of values recorded */
+    long long getCount();
+
+    /* The largest value recorded, 0 if none */
+    long long getMax();
+
+    /* The value not exceeded by percentile percent of the values 
+     * (from 0 to 100, e.g. 50 - the median, 99), the upper bound 
+     * of its bucket, 0 if no value is recorded */
+    long long getPercentile(double percentile);
+
+    /* Forgetting the values recorded, 
+     * not to be called while values are being recorded */
+    void reset();
+
+private:
+    std::vector<std::atomic<long long>> buckets;
+    std::atomic<long long> count;
+    std::atomic<long long> max;
+
+    /* The bucket of value */
+    static int _bucket(long long value);
+
+    /* The largest value of bucket */
+    static long long _upper(int bucket);
+};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Plan.h"
+#include <vector>
+
+namespace spectrum {
+
+/* Mel filterbank and MFCC of FFT spectra
+ *
+ * Triangular filters equally spaced on the mel scale 
+ * (2595 * log10(1 + f / 700)) from fmin to fmax, each one kept 
+ * sparse as its first FFT bin and its weights only, so a spectrum 
+ * is reduced in a single pass over the bins of the band: the power 
+ * of a bin is computed as it is weighted, no power spectrum is stored
+ *
+ * MFCC are the DCT-II (orthonormal) of the log energies of the filters
+ *
+ * T is the type of the spectrum values, float or double */
+template<typename T>
+class Mel {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* filters - number of mel filters, coefficients - number of MFCC 
+     * (at most filters) */
+    Mel(int NFFT, int sampleRate, int filters, int coefficients, float fmin, float fmax);
+    ~Mel();
+
+    /* Number of mel filters */
+    int getFilters();
+
+    /* Number of MFCC */
+    int getCoefficients();
+
+    /* Natural log of the energy of each filter of the spectrum 
+     * of NFFT / 2 + 1 values
+     *
+     * values receives getFilters() values */
+    void energies(const cpx_t* spectrum, T* values);
+
+    /* MFCC of the spectrum of NFFT / 2 + 1 values
+     *
+     * coefficients receives getCoefficients() values */
+    void mfcc(const cpx_t* spectrum, T* coefficients);
+
+private:
+    /* The first FFT bin of the m-th filter */
+    std::vector<int> start;
+
+    /* Weights of the m-th filter: weights[offset[m]] to weights[offset[m + 1]] */
+    std::vector<int> offset;
+    std::vector<T> weights;
+
+    /* DCT-II matrix, [c * filters + m] */
+    std::vector<T> dct;
+
+    /* Log energies for the MFCC */
+    std::vector<T> logEnergies;
+};
+}
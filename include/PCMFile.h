@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <istream>
+#include <cstdint>
+#include <cstddef>
+
+namespace spectrum {
+
+/* The format of the frames of an integer PCM WAV file */
+struct PCMFormat {
+    int channels;
+    int sampleRate;
+    int bitDepth;
+    /* Bytes per frame */
+    int blockAlign;
+    /* Number of frames of the data chunk */
+    size_t frames;
+};
+
+/* Reading the chunks of a WAV file up to its data chunk, 
+ * false if it is not an integer PCM WAV file, 
+ * otherwise in is left at the first frame */
+bool readPCMFormat(std::istream& in, PCMFormat& format);
+
+/* A sample of bytes bytes, little-endian, shifted to the top of int32_t
+ * (8 bit samples are unsigned, the others are signed) */
+int32_t decodePCMSample(const unsigned char* sample, int bytes);
+
+/* Integer PCM samples of a WAV file
+ *
+ * Unlike AudioFile, which converts every sample to floating point,
+ * the samples are read straight from the data chunk and only shifted 
+ * to the width of T (int16_t or int32_t), so the full scale of any 
+ * 8, 16, 24 or 32 bit file is the full scale of T:
+ * 
+ * a 16 bit sample is kept as is in int16_t, 
+ * a 24 bit sample loses its low 8 bits in int16_t 
+ * and keeps all of them in int32_t */
+template<typename T>
+class PCMFile {
+
+public:
+    PCMFile();
+    ~PCMFile();
+
+    /* Reading the audio file, false if it is not an integer PCM WAV file */
+    bool load(const char* FILE);
+
+    /* Sampling rate of the audio file */
+    int getSampleRate();
+
+    /* Bit depth of the samples in the audio file */
+    int getBitDepth();
+
+    /* Number of channels of the audio file */
+    int getNumChannels();
+
+    /* Number of samples per audio file channel */
+    int getNumSamplesPerChannel();
+
+    /* Duration of the audio file in seconds */
+    float getLengthInSeconds();
+
+    bool isMono();
+
+    /* Samples of each channel of the audio file
+     *
+     * [i][j] - i-th channel, j-th sample */
+    std::vector<std::vector<T>> samples;
+
+private:
+    int sampleRate;
+    int bitDepth;
+};
+}
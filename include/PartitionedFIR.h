@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Plan.h"
+#include <memory>
+#include <vector>
+
+namespace spectrum {
+
+/* Low-latency FIR filtering by uniformly partitioned convolution
+ * (overlap-save with a frequency-domain delay line)
+ *
+ * The L taps are cut into P = ceil(L / B) partitions of B taps, 
+ * the spectrum of each one is computed once by a real FFT of 2 * B points 
+ *
+ * Every block of B frames is transformed with the block before it, 
+ * its spectrum enters the delay line of the P last spectra, 
+ * the output is the inverse FFT of the sum of the products 
+ * of the p-th last spectrum by the p-th partition: 
+ * one FFT, one inverse FFT and P * (B + 1) complex products per block
+ *
+ * Unlike spectrum::FastFIR with a single block longer than the kernel, 
+ * the latency is B frames whatever the length of the kernel
+ *
+ * As spectrum::FastFIR, the FFT is the plan of the calling thread
+ *
+ * y[n] = sum of taps[k] * x[n - k], the frames before the signal are zero
+ *
+ * T is the type of the samples and of the taps, float or double */
+template<typename T>
+class PartitionedFIR {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* blockSize - B, frames per block, even block sizes suit the real FFT */
+    PartitionedFIR(const std::vector<T>& taps, int blockSize, Backend backend = KISSFFT);
+    ~PartitionedFIR();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* Frames per block, B */
+    int getBlockSize();
+
+    /* Number of partitions of the taps, P */
+    int getPartitions();
+
+    /* Clearing the delay line */
+    void reset();
+
+    /* Filtering the next block of B frames, out receives B frames */
+    void process(const T* block, T* out);
+
+private:
+    const int B;
+    const int P;
+    const Backend backend;
+
+    /* Spectra of the partitions divided by 2 * B, [p * (B + 1) + k] */
+    std::vector<cpx_t> partitions;
+
+    /* The P last input spectra as a circular buffer, 
+     * [j * (B + 1) + k], pos - the newest one */
+    std::vector<cpx_t> delay;
+    int pos;
+
+    /* The previous block followed by the current one */
+    std::vector<T> input;
+
+    /* Sum of the products and its inverse FFT */
+    std::vector<cpx_t> accumulator;
+    std::vector<T> result;
+};
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "kiss_fftr.h"
+#include "Stockham.h"
+#include <memory>
+
+extern "C" {
+/* kissfft with double precision scalars (src/kiss_fft_f64.c) */
+typedef struct {
+    double r;
+    double i;
+} kiss_fft_f64_cpx;
+
+typedef struct kiss_fft_f64_state* kiss_fft_f64_cfg;
+typedef struct kiss_fftr_f64_state* kiss_fftr_f64_cfg;
+
+kiss_fft_f64_cfg kiss_fft_f64_alloc(int nfft, int inverse_fft, void* mem, size_t* lenmem);
+void kiss_fft_f64(kiss_fft_f64_cfg cfg, const kiss_fft_f64_cpx* fin, kiss_fft_f64_cpx* fout);
+
+kiss_fftr_f64_cfg kiss_fftr_f64_alloc(int nfft, int inverse_fft, void* mem, size_t* lenmem);
+void kiss_fftr_f64(kiss_fftr_f64_cfg cfg, const double* timedata, kiss_fft_f64_cpx* freqdata);
+void kiss_fftri_f64(kiss_fftr_f64_cfg cfg, const kiss_fft_f64_cpx* freqdata, double* timedata);
+}
+
+namespace spectrum {
+
+/* FFT implementations available for the processing of an audio file */
+enum Backend {
+    /* Recursive mixed radix kissfft, kiss_fftr() */
+    KISSFFT,
+    /* Iterative Stockham autosort FFT (see spectrum::Stockham),
+     * window sizes it does not support are computed by KISSFFT */
+    STOCKHAM
+};
+
+/* Types of the FFT of T samples: cpx_t - a spectrum value */
+template<typename T>
+struct Scalar;
+
+template<>
+struct Scalar<float> {
+    typedef kiss_fft_cpx cpx_t;
+};
+
+template<>
+struct Scalar<double> {
+    typedef kiss_fft_f64_cpx cpx_t;
+};
+
+/* A real FFT of a fixed window size computed by one of the backends,
+ * allocated once and reused for every transform
+ *
+ * T is the type of the samples and of the spectrum values:
+ *
+ * float - kissfft or spectrum::Stockham (spectrum::Plan)
+ *
+ * double - kissfft with double precision scalars, 
+ * the STOCKHAM backend is computed by KISSFFT */
+template<typename T>
+class BasicPlan {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    BasicPlan(int NFFT, Backend backend = KISSFFT);
+    ~BasicPlan();
+
+    BasicPlan(const BasicPlan&) = delete;
+    BasicPlan& operator=(const BasicPlan&) = delete;
+
+    /* FFT window size */
+    int getNFFT();
+
+    /* The backend actually used for the transforms */
+    Backend getBackend();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* The plan of the window size and the backend for the calling thread, 
+     * allocated on its first request then reused by all the objects 
+     * of the thread (a plan is not shared by threads, the transforms 
+     * use its buffers): the plans of the last few sizes are kept */
+    static std::shared_ptr<BasicPlan> getShared(int NFFT, Backend backend = KISSFFT);
+
+    /* Performing the FFT of NFFT real samples
+     *
+     * freqdata receives NFFT / 2 + 1 non-normalized spectrum values */
+    void fftr(const T* timedata, cpx_t* freqdata);
+
+    /* Performing the inverse FFT of NFFT / 2 + 1 spectrum values
+     *
+     * timedata receives NFFT real samples multiplied by NFFT,
+     * the inverse is always computed by kissfft, 
+     * its configuration is allocated on the first call */
+    void fftri(const cpx_t* freqdata, T* timedata);
+
+private:
+    /* FFT window size */
+    const int NFFT;
+
+    Backend backend;
+
+    /* Configuration of the KISSFFT backend, float */
+    kiss_fftr_cfg cfg;
+
+    /* Configuration of the KISSFFT backend, double */
+    kiss_fftr_f64_cfg cfg64;
+
+    /* Configurations of the inverse FFT, float and double */
+    kiss_fftr_cfg icfg;
+    kiss_fftr_f64_cfg icfg64;
+
+    /* Engine of the STOCKHAM backend */
+    std::unique_ptr<Stockham> stockham;
+};
+
+/* The single precision FFT */
+typedef BasicPlan<float> Plan;
+}
@@ -2,48 +2,45 @@
 
 #include "kiss_fftr.h"
 #include "AudioFile.h"
+#include "Plan.h"
+#include "Common.h"
+#include "Goertzel.h"
+#include "SlidingDFT.h"
+#include "Zoom.h"
+#include "ConstantQ.h"
+#include "Mel.h"
+#include "Decimator.h"
+#include "Resampler.h"
+#include "FastFIR.h"
+#include "PartitionedFIR.h"
+#include "CrossCorrelation.h"
+#include "ReadAhead.h"
 #include <iostream>
 #include <memory>
 #include <cmath>
 #include <vector>
 #include <algorithm>
-
-#define EMPTY_CONTAINER "An empty container of the audio file spectrum, you did FFT or pFFT?\nYou may have called the wrong FFT Spectrum return method" 
-#define BAD_ALLOCATE "Memory resources cannot be allocated"
-#define BAD_NFFT "A number meaning size of the FFT window must be even and greater than 0"
-#define BAD_TIMESCALE "The entered time scaling ratio should not be less than 1 or more than 1000"
-#define BAD_CHANNEL "The requested channel does not match the available channels of the audio file" 
+#include <thread>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <limits>
 
 namespace spectrum {
 
 /* A class representing the processing of an audio file:
  * 
  * data reading, FFT implementation, normalization of the received spectrum,
- * obtaining audio file metadata */
-class Processing {
-
-private:
-    /* A structure containing FFT data */
-    template <typename v, typename sV>
-    struct Keepeth {
-        /* The channel to which the conversion refers */
-        int channel;
-        /* The number of frequencies per spectral component */
-        float freqPerBin;
-        /* The time point for which the FFT was made */
-        float time;
-        /* Non-normalized FFT values for the current time moment 
-         * that contain the kiss_fft_cpx structure:
-         * r - the real part of the spectrum, 
-         * i - the imaginary part of the spectrum */
-        v values;
-        /* Normalized FFT values for the current time moment */
-        sV scaledValues;  
-            
-        Keepeth(int ch, float fpb, float t, v vls, sV sVls);
-    };
+ * obtaining audio file metadata
+ *
+ * T is the type of the frames and of the FFT, float or double
+ * (see spectrum::Processing and spectrum::DoubleProcessing) */
+template<typename T>
+class BasicProcessing {
 
 public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
     /* A data type for public use, designed to simplify interaction 
      * and improve code readability. Serves as a storage 
      * for getpfftValues() and getpfftValues() values.
@@ -58,25 +55,59 @@ public:
      *
      * - float time - the time point for which the FFT was made
      *
-     * - std::vector<kiss_fft_cpx> values - 
+     * - float firstFreq - the frequency of the first value, 
+     * 0 unless the FFT was limited to a band
+     *
+     * - int frame - the first frame of the FFT window
+     *
+     * - int bins - the number of values, every call of FFT() and pFFT() 
+     * keeps the ones of its own band
+     *
+     * - std::vector<cpx_t> values - 
      * non-normalized FFT values for the current time moment 
-     * that contain the kiss_fft_cpx structure:
+     * that contain the kiss_fft_cpx (kiss_fft_f64_cpx for double) structure:
      *
      * r - the real part of the spectrum, 
      * i - the imaginary part of the spectrum
      * 
      * The operator<< is overloaded for this structure
      * 
-     * - std::vector<float> scaledValues - 
+     * - std::vector<T> scaledValues - 
      * normalized FFT values for the current time moment */
-    typedef std::vector<Keepeth<std::vector<kiss_fft_cpx>, 
-                                std::vector<float>>> storage_t;
+    typedef std::vector<Keepeth<std::vector<cpx_t>, 
+                                std::vector<T>>> storage_t;
     
-    Processing(int NFFT, const char* FILE);
-    ~Processing();
+    /* backend - the FFT implementation used by FFT() and pFFT() 
+     * (see spectrum::Backend, double is always computed by KISSFFT) 
+     *
+     * readAhead - an integer PCM WAV file is read by a thread 
+     * (see spectrum::ReadAhead): the constructor returns after its header, 
+     * pFFT() transforms the windows as soon as their frames are decoded, 
+     * the other methods wait for the whole file; 
+     * other files are read at once */
+    BasicProcessing(int NFFT, const char* FILE, Backend backend = KISSFFT, 
+                    bool readAhead = false);
+
+    /* The audio file read into memory beforehand (its whole content), 
+     * decoded by the constructor: FILE is only its name, 
+     * data has no frames if it cannot be decoded */
+    BasicProcessing(int NFFT, std::vector<uint8_t>& data, const char* FILE, 
+                    Backend backend = KISSFFT);
+
+    /* Another FFT window size for the audio file of source: 
+     * the decoded frames are shared, the file is not read again, 
+     * the object has its own storages 
+     *
+     * The frames are copied when one of the objects replaces them 
+     * (decimate(), resample(), filter(), ISTFT()) */
+    BasicProcessing(int NFFT, const BasicProcessing& source, Backend backend = KISSFFT);
+    ~BasicProcessing();
     
     /* FFT window size */
     int getNFFT();
+
+    /* The FFT implementation requested for the transforms */
+    Backend getBackend();
     
     /* The number of frequencies per spectral component
      * for a given FFT window size */
@@ -100,7 +131,7 @@ public:
     /* Frame values of each channel of the audio file
      *  
      * [i][j] - i-th channel, j-th frame */
-    std::vector<std::vector<float>> getFrames();
+    std::vector<std::vector<T>> getFrames();
     
     /* Bit depth of the frame */
     int getBitDepth();
@@ -111,6 +142,58 @@ public:
      * and an audio file to the console */
     void printSummary();
 
+    /* Anti-alias filtering and decimation of every channel 
+     * by an integer factor (see spectrum::Decimator), 
+     * the content above about 0.77 of the half of the new rate is lost
+     *
+     * The decimated frames replace the frames of the audio file 
+     * and the sample rate is divided by the factor, so the transforms 
+     * called afterwards work in the decimated domain: 
+     * NFFT, the time points and getFreqPerBin() refer to the decimated rate 
+     *
+     * The factor must divide the sample rate */
+    void decimate(int factor);
+
+    /* Resampling of every channel to sampleRate 
+     * by a rational polyphase filter (see spectrum::Resampler), 
+     * the content above about 0.77 of the half of the lower rate is lost
+     *
+     * As decimate(), the frames and the sample rate of the audio file 
+     * are replaced: files of different rates resampled to the same one 
+     * have the same getFreqPerBin() for the same NFFT */
+    void resample(int sampleRate);
+
+    /* FIR filtering of every channel by FFT fast convolution 
+     * (see spectrum::FastFIR), kernels of thousands of taps included: 
+     * y[n] = sum of taps[k] * x[n - k]
+     *
+     * The channels, and the parts of long channels, are filtered 
+     * by threads (0 - one per hardware thread), each one with its own plans 
+     *
+     * As decimate(), the frames of the audio file are replaced */
+    void filter(const std::vector<T>& taps, int threads = 0);
+
+    /* Inverse STFT: every spectrum of frames (such as getpfftValues() 
+     * or getsfftValues(), possibly modified) is transformed back 
+     * by the inverse FFT and overlap-added at its frame 
+     * with a Hann synthesis window, the sum is divided 
+     * by the sum of the windows, so unmodified spectra 
+     * give back the frames of the audio file 
+     *
+     * The frames of a channel not covered by any window are zero, 
+     * the channels without spectra are left as they are 
+     *
+     * The channels and their parts are resynthesized 
+     * by threads (0 - one per hardware thread), each one with the plan 
+     * of its thread (see spectrum::BasicPlan::getShared) 
+     *
+     * As decimate(), the frames of the audio file are replaced */
+    void ISTFT(const storage_t& frames, int threads = 0);
+
+    /* Writing the frames of the audio file to the WAV file path 
+     * (AudioFile::save) with its sample rate and bit depth */
+    bool save(const char* path);
+
     /* Values of the spectrum of each channel of the total audio file
      * 
      * Contains a std::vector of structures (see spectrum::Processing::storage_t) 
@@ -125,7 +208,7 @@ public:
      * for which the FFT was executed 
      *
      * The values for the channels are contained sequentially 
-     * (one after the other) */
+     * (one after the other), call after call */
     storage_t getpfftValues();
     
     /* Spectrum values for each time point of the audio file channel
@@ -134,6 +217,14 @@ public:
      * each of which is associated with a specific point in time 
      * for which the FFT was executed */
     storage_t getpfftValues(int channel);
+
+    /* Spectrum values for every hop of every channel of an audio file,
+     * computed by sFFT(), the channels are contained sequentially */
+    storage_t getsfftValues();
+
+    /* Spectrum values for every hop of the audio file channel,
+     * computed by sFFT() */
+    storage_t getsfftValues(int channel);
        
     /* Performing FFT of the total audio file 
      * 
@@ -141,6 +232,15 @@ public:
      * 
      * spectrum::Processing::getfftValues() */
     void FFT();
+
+    /* Performing FFT of the total audio file, 
+     * only the bins in the band [fmin, fmax] Hz are normalized and stored,
+     * their first frequency is firstFreq (see spectrum::Processing::storage_t)
+     *
+     * After successful execution of the method, allowed:
+     * 
+     * spectrum::Processing::getfftValues() */
+    void FFT(float fmin, float fmax);
     
     /* Performing FFT audio file for each time point 
      *
@@ -160,27 +260,143 @@ public:
      * spectrum::Processing::getpfftValues(int channel) */
     void pFFT(int timeScale /* = 1 */);
 
+    /* Performing FFT audio file for each time point (see pFFT(int timeScale)), 
+     * only the bins in the band [fmin, fmax] Hz are normalized and stored,
+     * their first frequency is firstFreq (see spectrum::Processing::storage_t)
+     *
+     * After successful execution of the method, allowed:
+     * 
+     * spectrum::Processing::getpfftValues()
+     * 
+     * spectrum::Processing::getpfftValues(int channel) */
+    void pFFT(int timeScale, float fmin, float fmax);
+
+    /* pFFT(timeScale) of several objects sharing the frames 
+     * of the same audio file (different FFT window sizes, 
+     * see the constructor from a source object) in one pass: 
+     * the window of each time point is read once 
+     * and transformed by every object into its own storage */
+    static void pFFT(const std::vector<BasicProcessing*>& configurations, int timeScale);
+
+    /* Magnitudes of the given frequencies (Hz) for each time point 
+     * of the audio file channel, computed by the Goertzel algorithm 
+     * (see spectrum::Goertzel) instead of the full FFT
+     *
+     * The time points are the ones of pFFT(timeScale), 
+     * NFFT frames each, the magnitudes are on the scale of the FFT values
+     *
+     * Returns a compact [time points x K] array of K frequencies:
+     * [j * K + k] - j-th time point, k-th frequency */
+    std::vector<T> detect(const std::vector<float>& frequencies, 
+                          int timeScale, int channel = 0);
+
+    /* Performing FFT of the audio file every hop frames (from 1 to NFFT) 
+     * by the sliding DFT (see spectrum::SlidingDFT): 
+     * the spectrum is updated frame by frame in O(NFFT) 
+     * instead of a full FFT per hop, for high-rate tracking 
+     * of spectral changes
+     *
+     * The time point of a spectrum is the beginning of its NFFT frames
+     *
+     * After successful execution of the method, allowed:
+     * 
+     * spectrum::Processing::getsfftValues()
+     * 
+     * spectrum::Processing::getsfftValues(int channel) */
+    void sFFT(int hop);
+
+    /* Zoom FFT of the band [fmin, fmax] Hz (see spectrum::Zoom):
+     * only the bins of the band are computed, resolution Hz apart 
+     * or closer, at a fraction of the cost and memory of an FFT 
+     * of the same resolution 
+     *
+     * Each channel is analyzed from its beginning, 
+     * over sampleRate / resolution frames or a little more 
+     * (zero padded past the end of the audio file)
+     *
+     * Returns the spectrum of the band of each channel, 
+     * the frequency of the j-th value is firstFreq + j * freqPerBin */
+    storage_t zoomFFT(float fmin, float fmax, float resolution);
+
+    /* Constant-Q transform of the audio file channel for each time point 
+     * of pFFT(timeScale) (see spectrum::ConstantQ): binsPerOctave 
+     * log-spaced bins per octave from fmin to fmax Hz, 
+     * f[k] = fmin * 2^(k / binsPerOctave)
+     *
+     * Each time point is one FFT of the window of the kernels,
+     * zero padded past the end of the audio file
+     *
+     * Returns a compact [time points x K] array of the magnitudes 
+     * of K bins: [j * K + k] - j-th time point, k-th bin */
+    std::vector<T> constantQ(float fmin, float fmax, int binsPerOctave, 
+                             int timeScale, int channel = 0);
+
+    /* Log energies of filters mel filters from fmin to fmax Hz 
+     * (see spectrum::Mel) of the audio file channel 
+     * for each time point of pFFT(timeScale)
+     *
+     * The filters are applied to each spectrum as it is computed, 
+     * no spectrum is stored
+     *
+     * Returns a compact [time points x filters] array:
+     * [j * filters + m] - j-th time point, m-th filter */
+    std::vector<T> mel(int filters, float fmin, float fmax, 
+                       int timeScale, int channel = 0);
+
+    /* The first coefficients MFCC of filters mel filters 
+     * from fmin to fmax Hz, as spectrum::Processing::mel()
+     *
+     * Returns a compact [time points x coefficients] array:
+     * [j * coefficients + c] - j-th time point, c-th coefficient */
+    std::vector<T> mfcc(int filters, int coefficients, float fmin, float fmax, 
+                        int timeScale, int channel = 0);
+
+    /* Time delays between the channels for each time point of pFFT(),
+     * from the spectra it stored (the whole band must be computed): 
+     * FFT cross-correlation of every pair of channels, 
+     * GCC-PHAT if phat (see spectrum::CrossCorrelation), the windows 
+     * are zero padded, so the correlation is linear, not circular
+     *
+     * maxDelay - the largest delay searched in seconds, 
+     * less than the FFT window, 0 - the half of the FFT window
+     *
+     * Returns a compact [time points x pairs] array of the delays in seconds,
+     * positive if the second channel of the pair comes after the first one:
+     * [j * pairs + p] - j-th time point, p-th pair, 
+     * the pairs are (0, 1), (0, 2) ... (1, 2) ... */
+    std::vector<T> delays(bool phat = true, float maxDelay = 0);
+
 private:
-    typedef std::vector<Keepeth<std::unique_ptr<kiss_fft_cpx>, 
-                                std::unique_ptr<kiss_fft_scalar>>> lstorage_t; 
+    typedef std::vector<Keepeth<std::unique_ptr<cpx_t[]>, 
+                                std::unique_ptr<T[]>>> lstorage_t; 
      
     /* FFT window size */
     const int NFFT;
 
     /* Path to the audio file */
     const char* FILE;
+
+    /* The FFT implementation used for the transforms */
+    const Backend backend;
     
     /* An object representing all the information
      * about the original audio file:
      *  - Metadata
-     *  - Signal frames */
-    AudioFile<float> file;
+     *  - Signal frames
+     *
+     * Shared by the objects created from this one, 
+     * copied before its frames are replaced (see _detach()) */
+    std::shared_ptr<AudioFile<T>> file;
+
+    /* The thread reading the frames of the audio file, 
+     * null once they are read at once */
+    std::shared_ptr<ReadAhead<T>> reader;
     
     /* Dynamic range
      * With a bit depth of 16 bits from 32767 to -32768 (65538) 
      * Is Equal to 96.33
      * We will use this value in the future to normalize the FFT values */
-    float dynamicRange;
+    T dynamicRange;
     
     /* A std::vector storing a structure that contains FFT data for a moment in time
      * pstorage[i].values.get() -
@@ -193,33 +409,65 @@ private:
      * means getting a pointer to an array of spectrum values  */
     lstorage_t storage;
 
-    /* Normalization of the resulting kiss_fft_cpx spectrum 
+    /* A std::vector storing a structure that contains FFT data 
+     * for every hop of sFFT(), by channels */
+    lstorage_t sstorage;
+
+    /* Normalization of the resulting cpx_t spectrum 
      * to the logarithmic scale
      * 
      * fft - pointer to an array of non-normalized spectrum
      * scaled - pointer to an empty array of normalized spectrum values 
-     * Arrays size is NFFT / 2 + 1 */
-    void scale(kiss_fft_cpx* fft, kiss_fft_scalar* scaled);
+     * S - arrays size, usually NFFT / 2 + 1 */
+    void scale(cpx_t* fft, T* scaled, const int S);
+
+    /* The bins of the band [fmin, fmax]: the first one and their number */
+    void _band(float fmin, float fmax, int& beg, int& bins);
+
+    /* FFT of NFFT frames, freqdata receives the bins of the band 
+     * spectrum - buffer of NFFT / 2 + 1 values, empty if the band is full */
+    void _fftr(BasicPlan<T>& plan, const T* timedata, std::vector<cpx_t>& spectrum, 
+               cpx_t* freqdata, const int beg, const int bins);
     
-    /* Formula for normalization of spectrum values */
-    float _scaleExpression(float r, float i);
+    /* pFFT() of the band [fmin, fmax] of every configuration, 
+     * the configurations share the frames of the same audio file */
+    static void _pFFT(const std::vector<BasicProcessing*>& configurations, 
+                      int timeScale, float fmin, float fmax);
+
+    /* Waiting until the first frames of every channel are read 
+     * (see spectrum::ReadAhead), all of them by default */
+    void _wait(int frames = std::numeric_limits<int>::max());
+
+    /* Taking a copy of the frames of the audio file if they are shared, 
+     * before they are replaced */
+    void _detach();
     
-    /* Copies an array of T* (not)normalized spectrum, signal frames 
-     * to a std::vector  
-     * S - array size */
-    template<typename T>
-    std::vector<T> _getVector(const T* t, const int S);
+    /* Mel features of the channel for each time point of pFFT(timeScale):
+     * the MFCC if coefficients > 0, the log energies of the filters otherwise */
+    std::vector<T> _mel(int filters, int coefficients, float fmin, float fmax, 
+                        int timeScale, int channel);
+    
+    /* Formula for normalization of spectrum values */
+    T _scaleExpression(T r, T i);
     
     /* Copies the lstorage_t containing pointers to the FFT data arrays 
      * to the storage_t in which the FFT data is stored as a std::vector, 
-     * then returns the storage 
-     * beg - begin index
-     * end - end index (usually s.size()) */
-    storage_t _peekValues(lstorage_t& s, const int beg, const int end);
+     * then returns the storage (see spectrum::peekValues)
+     * channel - only the entries of this channel, -1 for every channel */
+    storage_t _peekValues(lstorage_t& s, const int channel = -1);
 
     /* Terminate program with exitMessage */
     void _terminate(const char* exitMessage);
  
     };
+
+/* The single precision processing, the fastest one
+ * (a class up to 1.1.0, see "Changes from 1.1.0" in the README) */
+typedef BasicProcessing<float> Processing;
+
+/* The double precision processing, for long full-file transforms
+ * in which the float round-off dominates */
+typedef BasicProcessing<double> DoubleProcessing;
 }
 std::ostream& operator<<(std::ostream& os, kiss_fft_cpx const& k);
+std::ostream& operator<<(std::ostream& os, kiss_fft_f64_cpx const& k);
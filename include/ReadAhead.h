@@ -0,0 +1,59 @@
+#pragma once
+
+#include "AudioFile.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace spectrum {
+
+/* Asynchronous reading of an integer PCM WAV file into an AudioFile
+ *
+ * The header is read at once: the number of channels and frames, 
+ * the sample rate and the bit depth of the AudioFile are set 
+ * and its frames allocated, then a thread reads and decodes 
+ * the data chunk a block at a time while the frames already 
+ * decoded are transformed, so the disk and the CPU are busy together
+ *
+ * The frames are the same as of AudioFile::load() 
+ * (see spectrum::PCMFile for the integer samples)
+ *
+ * T is the type of the frames, float or double */
+template<typename T>
+class ReadAhead {
+
+public:
+    ReadAhead();
+
+    /* Stops the thread if the file is still being read */
+    ~ReadAhead();
+
+    ReadAhead(const ReadAhead&) = delete;
+    ReadAhead& operator=(const ReadAhead&) = delete;
+
+    /* Reading the header of the audio file FILE into file and starting 
+     * the thread reading its frames, false if it is not 
+     * an integer PCM WAV file (file is left as it is) */
+    bool start(const char* FILE, std::shared_ptr<AudioFile<T>> file);
+
+    /* Waiting until the first frames of every channel are decoded 
+     * (all of them if frames is larger than the file) */
+    void wait(int frames);
+
+    /* Waiting until all the frames are decoded */
+    void wait();
+
+private:
+    std::thread thread;
+
+    /* Frames decoded of every channel, guarded by mutex */
+    std::mutex mutex;
+    std::condition_variable decoded;
+    int frames;
+    bool finished;
+
+    std::atomic<bool> stop;
+};
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace spectrum {
+
+/* Rational polyphase resampling of a real signal from inRate to outRate
+ *
+ * The ratio is reduced to L / M (L = outRate / gcd, M = inRate / gcd): 
+ * the signal is upsampled by L, low-pass filtered and downsampled by M, 
+ * without computing the zeros of the upsampling nor the dropped outputs: 
+ * the filter is split into L phases of K taps, each output 
+ * is the product of one phase and K contiguous input frames 
+ * (a dot product by SSE, see Simd.h)
+ *
+ * The stopband of the filter begins at the half of the lower rate, 
+ * nothing is aliased, the passband goes up to about 0.77 of it 
+ *
+ * The filter bank of a ratio is computed once and shared by all the objects, 
+ * the banks of the last few ratios are kept for the next objects
+ *
+ * The resampler is stateful, as spectrum::FastFIR: the signal may be given 
+ * in chunks of any size, the outputs are the ones of the whole signal. 
+ * An output needs the input frames up to half of the filter after it, 
+ * so each chunk gives the outputs whose frames have all been given, 
+ * flush() gives the last ones (the frames after the signal are zero)
+ *
+ * T is the type of the samples, float or double */
+template<typename T>
+class Resampler {
+
+public:
+    Resampler(int inRate, int outRate);
+    ~Resampler();
+
+    /* Upsampling factor L */
+    int getUp();
+
+    /* Downsampling factor M */
+    int getDown();
+
+    /* Number of outputs of a signal of N frames, ceil(N * L / M) */
+    int getSize(int N);
+
+    /* Number of outputs still given by flush() */
+    int getPending();
+
+    /* Clearing the frames and the position of the previous chunks */
+    void reset();
+
+    /* Resampling the next N frames of the signal, out receives 
+     * up to getSize(N) frames and the number of them is returned, 
+     * the m-th output of the signal is at the time m / outRate 
+     * (the frames before the signal are zero) */
+    int process(const T* samples, const int N, T* out);
+
+    /* Ending the signal: out receives the getPending() last outputs, 
+     * the number of them is returned, then the resampler is reset */
+    int flush(T* out);
+
+private:
+    /* Polyphase filter bank of a ratio */
+    struct Bank {
+        int L;
+        int M;
+        /* Taps per phase */
+        int K;
+        /* Half of the length of the filter at the upsampled rate, 
+         * the delay compensated */
+        int half;
+        /* [p * K + k] - the taps of the p-th phase in reverse order, 
+         * multiplied by L */
+        std::vector<T> taps;
+    };
+
+    std::shared_ptr<const Bank> bank;
+
+    /* The K - 1 last frames given followed by the frames of the chunk */
+    std::vector<T> buffer;
+
+    /* Number of frames given since the reset */
+    long long frames;
+
+    /* Index of the next output since the reset */
+    long long next;
+
+    /* The outputs before last whose frames are all in the chunk, 
+     * returns their number */
+    int _run(const T* samples, const int N, T* out, long long last);
+
+    /* The filter bank of the ratio, computed on the first request */
+    static std::shared_ptr<const Bank> _bank(int L, int M);
+};
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace spectrum {
+
+/* Wait-free ring buffer of one producer thread and one consumer thread
+ *
+ * The values are stored in a buffer allocated by the constructor, 
+ * push() and pop() never allocate, lock or wait: each side only 
+ * writes its own index and reads the other one, the values are 
+ * published by the release store of the index and seen by the acquire load 
+ * of the other side, so a real-time thread may push into it 
+ * 
+ * T is the type of the values */
+template<typename T>
+class Ring {
+
+public:
+    /* capacity - the maximum number of values kept, 
+     * rounded up to a power of 2 */
+    Ring(int capacity);
+    ~Ring();
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    /* The maximum number of values kept */
+    int getCapacity();
+
+    /* Number of values kept, at the time of the call: 
+     * the other thread may push or pop meanwhile */
+    int size();
+
+    /* Adding up to n values, only as many as there is room for, 
+     * returns the number of values added 
+     *
+     * Called by the producer thread only */
+    int push(const T* values, int n);
+
+    /* Taking up to n values, the oldest ones first, 
+     * returns the number of values taken 
+     *
+     * Called by the consumer thread only */
+    int pop(T* values, int n);
+
+private:
+    std::vector<T> buffer;
+
+    /* capacity - 1, the indices grow without bounds 
+     * and are taken modulo the capacity */
+    const size_t mask;
+
+    /* The next value to push, written by the producer only */
+    std::atomic<size_t> head;
+
+    /* The indices are kept apart on their own cache lines, 
+     * so the two threads do not invalidate each other's line 
+     * on every push and pop */
+    char padding[64];
+
+    /* The next value to pop, written by the consumer only */
+    std::atomic<size_t> tail;
+};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+/* Vectorized loops of the FIR filters (spectrum::Decimator, spectrum::Resampler)
+ *
+ * SSE2 on x86, as the butterflies of kissfft (KISS_FFT_SSE):
+ * 4 float or 2 double values per register, the remainder
+ * by the scalar code. SSE2 is always present on x86-64,
+ * define KISS_FFT_NO_SSE to use the scalar code everywhere */
+#if !defined(KISS_FFT_NO_SSE) && (defined(__SSE2__) || defined(_M_X64))
+# define SPECTRUM_SSE
+# include <emmintrin.h>
+#endif
+
+namespace spectrum {
+namespace simd {
+
+/* The sum of h[k] * x[k], k from 0 to K - 1 */
+inline float dot(const float* h, const float* x, const int K) {
+    float s = 0;
+    int k = 0;
+#ifdef SPECTRUM_SSE
+    /* Two registers of partial sums, independent multiply-adds */
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    for (; k + 8 <= K; k += 8) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(h + k), _mm_loadu_ps(x + k)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(h + k + 4), _mm_loadu_ps(x + k + 4)));
+    }
+    float p[4];
+    _mm_storeu_ps(p, _mm_add_ps(s0, s1));
+    s = (p[0] + p[1]) + (p[2] + p[3]);
+#endif
+    for (; k < K; k++)
+        s += h[k] * x[k];
+    return s;
+};
+
+inline double dot(const double* h, const double* x, const int K) {
+    double s = 0;
+    int k = 0;
+#ifdef SPECTRUM_SSE
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    for (; k + 4 <= K; k += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(h + k), _mm_loadu_pd(x + k)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(h + k + 2), _mm_loadu_pd(x + k + 2)));
+    }
+    double p[2];
+    _mm_storeu_pd(p, _mm_add_pd(s0, s1));
+    s = p[0] + p[1];
+#endif
+    for (; k < K; k++)
+        s += h[k] * x[k];
+    return s;
+};
+
+/* y[i] += c * x[i], i from 0 to n - 1 */
+inline void axpy(const float c, const float* x, float* y, const int n) {
+    int i = 0;
+#ifdef SPECTRUM_SSE
+    const __m128 v = _mm_set1_ps(c);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(v, _mm_loadu_ps(x + i))));
+#endif
+    for (; i < n; i++)
+        y[i] += c * x[i];
+};
+
+inline void axpy(const double c, const double* x, double* y, const int n) {
+    int i = 0;
+#ifdef SPECTRUM_SSE
+    const __m128d v = _mm_set1_pd(c);
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(v, _mm_loadu_pd(x + i))));
+#endif
+    for (; i < n; i++)
+        y[i] += c * x[i];
+};
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Plan.h"
+#include <vector>
+
+namespace spectrum {
+
+/* Sliding DFT of the last NFFT samples of a real signal
+ *
+ * Every new sample updates all NFFT / 2 + 1 spectrum values in O(NFFT):
+ * X[k] = (X[k] + x[n] - x[n - NFFT]) * exp(2 * pi * i * k / NFFT),
+ * instead of a full FFT per sample 
+ *
+ * The recurrence accumulates round-off, so every resync samples 
+ * the values are recomputed from the window by the FFT, 
+ * the plan of the calling thread (see spectrum::BasicPlan::getShared)
+ *
+ * T is the type of the samples and of the spectrum values, float or double */
+template<typename T>
+class SlidingDFT {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* resync - number of samples between the recomputations by the FFT, 
+     * NFFT if 0 */
+    SlidingDFT(int NFFT, int resync = 0, Backend backend = KISSFFT);
+    ~SlidingDFT();
+
+    /* FFT window size */
+    int getNFFT();
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* Restarting from a window of NFFT samples, computed by the FFT */
+    void reset(const T* samples);
+
+    /* Adding a sample to the window, the oldest one leaves it */
+    void push(T sample);
+
+    /* The spectrum of the window, oldest sample first,
+     * the same values as spectrum::BasicPlan::fftr() of the window
+     *
+     * freqdata receives NFFT / 2 + 1 values */
+    void values(cpx_t* freqdata);
+
+private:
+    /* FFT window size */
+    const int NFFT;
+
+    /* Number of samples between the recomputations by the FFT */
+    const int resync;
+
+    /* Samples since the last recomputation */
+    int count;
+
+    /* The window as a circular buffer, pos - the oldest sample */
+    std::vector<T> window;
+    int pos;
+
+    /* Spectrum values, real and imaginary parts apart 
+     * so that the update is vectorized */
+    std::vector<T> re;
+    std::vector<T> im;
+
+    /* exp(2 * pi * i * k / NFFT) */
+    std::vector<T> wr;
+    std::vector<T> wi;
+
+    const Backend backend;
+
+    /* Window in time order and its FFT, for the recomputations */
+    std::vector<T> linear;
+    std::vector<cpx_t> freq;
+
+    /* Recomputation of the values from the window */
+    void _recompute();
+};
+}
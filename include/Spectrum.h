@@ -1,3 +1,6 @@
 #pragma once
 
 #include "Processing.h"
+#include "FixedProcessing.h"
+#include "Batch.h"
+#include "Stream.h"
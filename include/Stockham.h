@@ -0,0 +1,64 @@
+#pragma once
+
+#include "kiss_fft.h"
+#include <vector>
+
+namespace spectrum {
+
+/* Iterative Stockham autosort FFT of a real input signal
+ *
+ * An alternative to the recursive kissfft decimation: each pass
+ * reads and writes the whole array with unit-stride inner loops,
+ * alternating between two buffers, so neither strided gathers
+ * nor a bit-reversal permutation are needed
+ *
+ * The NFFT / 2 point complex FFT is computed in radix 4, 2, 3 and 5 passes,
+ * so NFFT / 2 must only have the factors 2, 3 and 5
+ * (see spectrum::Stockham::isSupported) */
+class Stockham {
+
+public:
+    Stockham(int NFFT);
+    ~Stockham();
+
+    /* Whether the FFT window size can be computed by this engine */
+    static bool isSupported(int NFFT);
+
+    /* Performing the FFT of NFFT real samples
+     *
+     * freqdata receives NFFT / 2 + 1 spectrum values,
+     * the same layout as kiss_fftr() */
+    void fftr(const kiss_fft_scalar* timedata, kiss_fft_cpx* freqdata);
+
+private:
+    /* Size of the complex FFT, NFFT / 2 */
+    const int N;
+
+    /* The radix of each pass, in order of execution */
+    std::vector<int> radices;
+
+    /* Twiddle factors of all passes, one after the other
+     *
+     * For a pass of radix p after sub-transforms of size s
+     * the factors w^(r * k) are stored at [(r - 1) * s + k],
+     * r = 1..p-1, k = 0..s-1, so that they are read with a unit stride */
+    std::vector<kiss_fft_cpx> twiddles;
+
+    /* Factors combining the complex FFT of the even and odd samples
+     * into the spectrum of the real signal */
+    std::vector<kiss_fft_cpx> superTwiddles;
+
+    /* Work buffers, every pass reads one and writes the other */
+    std::vector<kiss_fft_cpx> work[2];
+
+    /* Pass of radix P: sub-transforms of size s are combined
+     * into sub-transforms of size s * P */
+    template<int P>
+    void _pass(const int s, const kiss_fft_cpx* tw,
+               const kiss_fft_cpx* x, kiss_fft_cpx* y);
+
+    /* DFT of P values in place */
+    template<int P>
+    static void _butterfly(kiss_fft_cpx* v);
+};
+}
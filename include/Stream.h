@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Common.h"
+#include "Plan.h"
+#include "PartitionedFIR.h"
+#include "Ring.h"
+#include "Histogram.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace spectrum {
+
+/* What a stream does when the analysis falls behind the frames pushed */
+enum Overflow {
+    /* The frames that do not fit into the ring are dropped by push() */
+    DROP,
+    /* When more than NFFT frames wait in the ring, they are analyzed at once 
+     * and only the spectrum of the newest window is emitted, 
+     * the analysis catches up with the stream (then as DROP) */
+    COALESCE,
+    /* push() waits until the frames fit into the ring, 
+     * not for real-time threads, no frame is lost */
+    BLOCK
+};
+
+/* Real-time analysis of a live stream of frames
+ *
+ * The audio thread pushes the frames into a wait-free ring 
+ * (see spectrum::Ring), push() never allocates, locks or waits 
+ * for the analysis (see spectrum::Overflow for the frames that do not fit)
+ *
+ * An analysis thread pops the frames a hop at a time and emits 
+ * the spectrum of the last NFFT frames of every channel, 
+ * the same values as pFFT() of spectrum::Processing 
+ * for a window starting at the same frame
+ *
+ * The frames may be FIR filtered before the analysis (see setFilter()) 
+ * by uniformly partitioned convolution of a hop per block 
+ * (see spectrum::PartitionedFIR): the filter adds no latency 
+ * to the one of the hop, whatever the length of the kernel
+ *
+ * The latency of every spectrum, from push() of the last frame 
+ * of its window to its emission, is recorded in a histogram 
+ * (see getLatency()), to size NFFT and the hop against a deadline
+ *
+ * T is the type of the frames and of the FFT, float or double */
+template<typename T>
+class BasicStream {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* The spectrum of a window of a channel (NFFT / 2 + 1 values), 
+     * frame - the first frame of the window since the beginning of the stream, 
+     * time - the same in seconds */
+    typedef Keepeth<std::vector<cpx_t>, std::vector<T>> frame_t;
+
+    /* Receives every spectrum, called by the analysis thread, 
+     * the frame is reused for the next window once it returns */
+    typedef std::function<void(const frame_t& frame)> callback_t;
+
+    /* NFFT - FFT window size, hop - frames between the windows (from 1 to NFFT), 
+     * sampleRate and channels of the stream, callback - see callback_t 
+     *
+     * bitDepth - the dynamic range of scaledValues, as of the audio files
+     * 
+     * capacity - frames kept by the ring until the analysis thread pops them, 
+     * rounded up to a power of 2, 0 - one second 
+     *
+     * overflow - when the analysis falls behind, see spectrum::Overflow */
+    BasicStream(int NFFT, int hop, int sampleRate, int channels, callback_t callback, 
+                Backend backend = KISSFFT, int bitDepth = 16, int capacity = 0, 
+                Overflow overflow = DROP);
+    
+    /* Stops the analysis (see stop()) */
+    ~BasicStream();
+
+    BasicStream(const BasicStream&) = delete;
+    BasicStream& operator=(const BasicStream&) = delete;
+
+    int getNFFT();
+    int getHop();
+    int getSampleRate();
+    int getChannels();
+    float getFreqPerBin();
+    Overflow getOverflow();
+
+    /* FIR filtering of every channel before the analysis: 
+     * y[n] = sum of taps[k] * x[n - k], the frames before the stream are zero
+     *
+     * Called before the first push(), by the producer thread */
+    void setFilter(const std::vector<T>& taps);
+
+    /* Adding n frames, interleaved as in a WAV file (n * channels values) 
+     * in the range [-1.0, 1.0], returns the number of frames added, 
+     * the rest did not fit into the ring and is dropped 
+     *
+     * Called by one producer thread only, 
+     * never blocks unless the overflow is BLOCK */
+    int push(const T* frames, int n);
+
+    /* Frames dropped by push() since the beginning of the stream */
+    long long getDropped();
+
+    /* Windows whose spectrum was not emitted by COALESCE */
+    long long getCoalesced();
+
+    /* Latencies of the spectra emitted, in nanoseconds: 
+     * from push() of the last frame of the window to the call of the callback, 
+     * e.g. getLatency().getPercentile(99), getLatency().getMax() */
+    Histogram& getLatency();
+
+    /* Analyzing the hops of frames pushed before the call, 
+     * then stopping the analysis thread, push() must not be called anymore */
+    void stop();
+
+private:
+    const int NFFT;
+    const int hop;
+    const int sampleRate;
+    const int channels;
+    const callback_t callback;
+    const Overflow overflow;
+
+    /* See BasicProcessing::dynamicRange */
+    const T dynamicRange;
+
+    BasicPlan<T> plan;
+
+    /* The filter of every channel, none if empty, a block is a hop */
+    std::vector<std::unique_ptr<PartitionedFIR<T>>> filters;
+
+    /* The hop of a channel to be filtered */
+    std::vector<T> unfiltered;
+
+    /* Interleaved frames not yet analyzed */
+    Ring<T> ring;
+
+    /* Pushed before the frames they refer to, two values each: 
+     * the number of frames pushed up to the end of a push(), its time (see _now()) */
+    Ring<long long> marks;
+
+    /* Frames pushed, written by the producer only */
+    long long pushed;
+    std::atomic<long long> dropped;
+
+    /* The mark of the last frame of the last window, read by the consumer */
+    long long mark[2];
+    
+    std::atomic<long long> coalesced;
+    Histogram latency;
+
+    /* The hop popped from the ring, interleaved */
+    std::vector<T> block;
+
+    /* The last NFFT frames of every channel, oldest first */
+    std::vector<std::vector<T>> windows;
+
+    /* Frames analyzed since the beginning of the stream */
+    long long received;
+
+    /* The spectrum of every channel, reused for every window */
+    std::vector<frame_t> frames;
+
+    std::atomic<bool> stopping;
+    std::thread thread;
+
+    /* The analysis thread */
+    void _run();
+
+    /* Adding the hop of block to the windows, 
+     * emitting their spectra once they are full if emit */
+    void _analyze(bool emit);
+
+    /* Nanoseconds of a monotonic clock */
+    static long long _now();
+
+    /* The time between two looks into the ring, a part of a hop */
+    std::chrono::microseconds _poll();
+};
+
+/* Real-time analysis in single precision */
+typedef BasicStream<float> Stream;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spectrum {
+
+/* A pool of worker threads with work stealing
+ *
+ * Every worker has its own queue of tasks, the tasks are given 
+ * to the queues in turn: a worker runs the tasks of its queue 
+ * from the newest one, when its queue is empty it takes 
+ * the oldest task of another queue, so no worker stays idle 
+ * while tasks are waiting, whatever their durations */
+class WorkPool {
+
+public:
+    /* threads - number of workers, 0 - one per hardware thread */
+    WorkPool(int threads = 0);
+
+    /* Waits for the tasks submitted, then stops the workers */
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /* Number of workers */
+    int getThreads();
+
+    /* Adding a task to the queue of the next worker, 
+     * may be called by several threads, the workers included */
+    void submit(std::function<void()> task);
+
+    /* Waiting until all the tasks submitted are done, 
+     * the ones submitted by other threads included */
+    void wait();
+
+private:
+    struct Queue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    /* The queue of the next task submitted */
+    std::atomic<unsigned> next;
+
+    /* Tasks waiting in the queues, tasks not done yet, 
+     * guarded by mutex */
+    std::mutex mutex;
+    std::condition_variable available;
+    std::condition_variable done;
+    int queued;
+    int pending;
+    bool stop;
+
+    /* Taking a task of the queue w, or of another queue */
+    bool _take(int w, std::function<void()>& task);
+
+    /* The loop of the worker w */
+    void _work(int w);
+};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Plan.h"
+#include <vector>
+
+namespace spectrum {
+
+/* Zoom FFT of a narrow band [fmin, fmax] of a real signal
+ *
+ * The band is mixed down to 0 Hz by its centre frequency, 
+ * low-pass filtered and decimated, then a small complex FFT 
+ * of the decimated signal gives the bins of the band only, 
+ * at the resolution of a far larger FFT of the whole signal 
+ *
+ * The decimation D is the largest one keeping the band, 
+ * the FFT has M >= (sampleRate / D) / resolution points,
+ * so getInputSize() = M * D frames of the signal are analyzed
+ *
+ * T is the type of the samples and of the spectrum values, float or double */
+template<typename T>
+class Zoom {
+
+public:
+    typedef typename Scalar<T>::cpx_t cpx_t;
+
+    /* fmin, fmax - the band in Hz, resolution - the largest 
+     * distance between two bins in Hz */
+    Zoom(float fmin, float fmax, float resolution, int sampleRate);
+    ~Zoom();
+
+    Zoom(const Zoom&) = delete;
+    Zoom& operator=(const Zoom&) = delete;
+
+    /* false if the memory resources of the FFT cannot be allocated */
+    bool isValid();
+
+    /* Number of frames of the signal analyzed, M * D */
+    int getInputSize();
+
+    /* Number of bins of the band */
+    int getSize();
+
+    /* The frequency of the first bin of the band */
+    float getFirstFreq();
+
+    /* The distance between two bins, the actual resolution */
+    float getFreqPerBin();
+
+    /* Performing the zoom FFT of the first getInputSize() samples,
+     * zero padded if N is less
+     *
+     * values receives getSize() spectrum values, on the scale 
+     * of the FFT of getInputSize() samples */
+    void transform(const T* samples, const int N, cpx_t* values);
+
+private:
+    const int sampleRate;
+
+    /* Centre frequency of the band */
+    const double centre;
+
+    /* Decimation factor D and FFT size M */
+    int D;
+    int M;
+
+    /* Index of the first bin of the band, from -M / 2 */
+    int first;
+    int size;
+
+    /* Low-pass filter, odd length, centred on its middle tap */
+    std::vector<T> taps;
+
+    /* The mixed down signal, real and imaginary parts apart */
+    std::vector<T> re;
+    std::vector<T> im;
+
+    /* Decimated signal and its FFT */
+    std::vector<cpx_t> decimated;
+    std::vector<cpx_t> freq;
+
+    /* Configurations of the complex FFT, float and double */
+    kiss_fft_cfg cfg;
+    kiss_fft_f64_cfg cfg64;
+
+    /* Allocation of the complex FFT of M points */
+    void _alloc();
+
+    /* The complex FFT of decimated into freq */
+    void _fft();
+};
+}
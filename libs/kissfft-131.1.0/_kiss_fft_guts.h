@@ -24,10 +24,40 @@
  4*4*4*2
  */
 
+/* Sizes whose largest prime factor exceeds this are computed with
+   Bluestein's chirp-z algorithm (a power of two convolution) instead of
+   the O(p^2) kf_bfly_generic stage. Floating point builds only. */
+#if !defined(FIXED_POINT) && !defined(USE_SIMD)
+# ifndef KISS_FFT_BLUESTEIN_THRESHOLD
+#  define KISS_FFT_BLUESTEIN_THRESHOLD 100
+# endif
+#endif
+
+/* Sizes of at least this many points are computed with the four-step
+   (Bailey) algorithm: nfft = n1*n2 is split into cache sized FFTs
+   joined by blocked transposes, instead of recursing over the whole array.
+   Floating point builds only, as Bluestein's algorithm above:
+   the fixed point builds (src/kiss_fft_i16.c) keep the mixed radix path */
+#ifndef FIXED_POINT
+# ifndef KISS_FFT_FOURSTEP_THRESHOLD
+#  define KISS_FFT_FOURSTEP_THRESHOLD 2097152
+# endif
+#endif
+
 struct kiss_fft_state{
     int nfft;
     int inverse;
     int factors[2*MAXFACTORS];
+    /* Bluestein convolution size, 0 if the mixed radix path is used.
+       If set, twiddles[nfft] is followed by the chirp (nfft elements),
+       the convolution filter spectrum (bluestein_nfft elements)
+       and the state of the bluestein_nfft forward FFT */
+    int bluestein_nfft;
+    /* Four-step split nfft = fourstep_n1 * (nfft/fourstep_n1), 0 if unused.
+       If set, twiddles[nfft] is followed by the states of the fourstep_n1
+       and the nfft/fourstep_n1 point FFTs, fourstep_offset bytes apart */
+    int fourstep_n1;
+    int fourstep_offset;
     kiss_fft_cpx twiddles[1];
 };
 
@@ -150,6 +180,49 @@ struct kiss_fft_state{
     KISS_FFT_DEBUG("%g + %gi\n",(double)((c)->r),(double)((c)->i))
 
 
+/*
+  Vectorized butterflies within a single transform: two complex values
+  r0,i0,r1,i1 are held in one SSE register. Default float builds on x86
+  only, define KISS_FFT_NO_SSE to use the scalar code everywhere.
+  (USE_SIMD is a different thing: 4 separate transforms at once)
+ */
+#if defined(KISS_FFT_FLOAT_SCALAR) && !defined(KISS_FFT_NO_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64))
+# define KISS_FFT_SSE
+# include <emmintrin.h>
+# ifdef __SSE3__
+#  include <pmmintrin.h>
+# endif
+
+/* loads the complex values a and b into one register */
+static inline __m128 kf_sse_load2(const kiss_fft_cpx * a,const kiss_fft_cpx * b)
+{
+    return _mm_loadh_pi( _mm_loadl_pi( _mm_setzero_ps(), (const __m64*)a ), (const __m64*)b );
+}
+
+/* the two complex products a*b */
+static inline __m128 kf_sse_cmul(__m128 a,__m128 b)
+{
+    __m128 re = _mm_mul_ps( a, _mm_shuffle_ps(b,b,_MM_SHUFFLE(2,2,0,0)) );
+    __m128 im = _mm_mul_ps( _mm_shuffle_ps(a,a,_MM_SHUFFLE(2,3,0,1)),
+                            _mm_shuffle_ps(b,b,_MM_SHUFFLE(3,3,1,1)) );
+# ifdef __SSE3__
+    return _mm_addsub_ps(re,im);
+# else
+    return _mm_add_ps( re, _mm_xor_ps(im, _mm_set_ps(0.f,-0.f,0.f,-0.f)) );
+# endif
+}
+
+/* the two values multiplied by -i (sign = kf_sse_rot_sign(0))
+   or by +i (sign = kf_sse_rot_sign(1)) */
+#define kf_sse_rot_sign(inverse) \
+    ( (inverse) ? _mm_set_ps(0.f,-0.f,0.f,-0.f) : _mm_set_ps(-0.f,0.f,-0.f,0.f) )
+static inline __m128 kf_sse_rot(__m128 a,__m128 sign)
+{
+    return _mm_xor_ps( _mm_shuffle_ps(a,a,_MM_SHUFFLE(2,3,0,1)), sign );
+}
+#endif
+
 #ifdef KISS_FFT_USE_ALLOCA
 // define this to allow use of alloca instead of malloc for temporary buffers
 // Temporary buffers are used in two case:
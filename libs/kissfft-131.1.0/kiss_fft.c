@@ -8,6 +8,9 @@
 
 
 #include "_kiss_fft_guts.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 /* The guts header contains all the multiplication and addition macros that are defined for
  fixed or floating point complex numbers.  It also delares the kf_ internal functions.
  */
@@ -23,6 +26,19 @@ static void kf_bfly2(
     kiss_fft_cpx * tw1 = st->twiddles;
     kiss_fft_cpx t;
     Fout2 = Fout + m;
+#ifdef KISS_FFT_SSE
+    for (; m > 1; m -= 2) {
+        __m128 a = _mm_loadu_ps((float*)Fout);
+        __m128 b = kf_sse_cmul( _mm_loadu_ps((float*)Fout2), kf_sse_load2(tw1,tw1+fstride) );
+        tw1 += 2*fstride;
+        _mm_storeu_ps((float*)Fout2, _mm_sub_ps(a,b));
+        _mm_storeu_ps((float*)Fout, _mm_add_ps(a,b));
+        Fout2 += 2;
+        Fout += 2;
+    }
+    if (!m)
+        return;
+#endif
     do{
         C_FIXDIV(*Fout,2); C_FIXDIV(*Fout2,2);
 
@@ -51,6 +67,32 @@ static void kf_bfly4(
 
     tw3 = tw2 = tw1 = st->twiddles;
 
+#ifdef KISS_FFT_SSE
+    {
+        const __m128 sign = kf_sse_rot_sign(st->inverse);
+        for (; k > 1; k -= 2) {
+            __m128 f0 = _mm_loadu_ps((float*)Fout);
+            __m128 s0 = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+m)), kf_sse_load2(tw1,tw1+fstride) );
+            __m128 s1 = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+m2)), kf_sse_load2(tw2,tw2+2*fstride) );
+            __m128 s2 = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+m3)), kf_sse_load2(tw3,tw3+3*fstride) );
+            __m128 s5 = _mm_sub_ps(f0,s1);
+            __m128 s3 = _mm_add_ps(s0,s2);
+            __m128 s4 = kf_sse_rot( _mm_sub_ps(s0,s2), sign );
+            f0 = _mm_add_ps(f0,s1);
+            tw1 += 2*fstride;
+            tw2 += 4*fstride;
+            tw3 += 6*fstride;
+            _mm_storeu_ps((float*)(Fout+m2), _mm_sub_ps(f0,s3));
+            _mm_storeu_ps((float*)Fout, _mm_add_ps(f0,s3));
+            _mm_storeu_ps((float*)(Fout+m), _mm_add_ps(s5,s4));
+            _mm_storeu_ps((float*)(Fout+m3), _mm_sub_ps(s5,s4));
+            Fout += 2;
+        }
+        if (!k)
+            return;
+    }
+#endif
+
     do {
         C_FIXDIV(*Fout,4); C_FIXDIV(Fout[m],4); C_FIXDIV(Fout[m2],4); C_FIXDIV(Fout[m3],4);
 
@@ -188,6 +230,172 @@ static void kf_bfly5(
     }
 }
 
+static void kf_bfly8(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        const size_t m
+        )
+{
+    /* The 8-point DFT is split into a radix-2 pass followed by two radix-4
+       DFTs (split-radix form): the odd half only needs the W8^1, W8^2, W8^3
+       rotations, which cost 2 real multiplies, 0 and 2 respectively. */
+    kiss_fft_cpx *tw1,*tw2,*tw3,*tw4,*tw5,*tw6,*tw7;
+    kiss_fft_cpx scratch[8];
+    kiss_fft_cpx a[4],b[4],s[4],t;
+    kiss_fft_scalar c;
+    size_t k=m;
+
+    /* W8 = exp(-+ i*pi/4), its real part is sqrt(1/2) for either direction */
+    c = st->twiddles[fstride*m].r;
+
+    tw7 = tw6 = tw5 = tw4 = tw3 = tw2 = tw1 = st->twiddles;
+
+#ifdef KISS_FFT_SSE
+    {
+        const __m128 sign = kf_sse_rot_sign(st->inverse);
+        const __m128 vc = _mm_set1_ps(c);
+        __m128 x[8],va[4],vb[4],vs[4];
+        for (; k > 1; k -= 2) {
+            x[0] = _mm_loadu_ps((float*)Fout);
+            x[1] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+m)), kf_sse_load2(tw1,tw1+fstride) );
+            x[2] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+2*m)), kf_sse_load2(tw2,tw2+2*fstride) );
+            x[3] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+3*m)), kf_sse_load2(tw3,tw3+3*fstride) );
+            x[4] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+4*m)), kf_sse_load2(tw4,tw4+4*fstride) );
+            x[5] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+5*m)), kf_sse_load2(tw5,tw5+5*fstride) );
+            x[6] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+6*m)), kf_sse_load2(tw6,tw6+6*fstride) );
+            x[7] = kf_sse_cmul( _mm_loadu_ps((float*)(Fout+7*m)), kf_sse_load2(tw7,tw7+7*fstride) );
+            tw1 += 2*fstride;
+            tw2 += 4*fstride;
+            tw3 += 6*fstride;
+            tw4 += 8*fstride;
+            tw5 += 10*fstride;
+            tw6 += 12*fstride;
+            tw7 += 14*fstride;
+
+            va[0] = _mm_add_ps(x[0],x[4]); vb[0] = _mm_sub_ps(x[0],x[4]);
+            va[1] = _mm_add_ps(x[1],x[5]); vb[1] = _mm_sub_ps(x[1],x[5]);
+            va[2] = _mm_add_ps(x[2],x[6]); vb[2] = _mm_sub_ps(x[2],x[6]);
+            va[3] = _mm_add_ps(x[3],x[7]); vb[3] = _mm_sub_ps(x[3],x[7]);
+
+            /* W8^1 = c*(1 -+ i), W8^2 = -+i, W8^3 = c*(-1 -+ i) */
+            vb[1] = _mm_mul_ps(vc, _mm_add_ps(vb[1], kf_sse_rot(vb[1],sign)));
+            vb[2] = kf_sse_rot(vb[2],sign);
+            vb[3] = _mm_mul_ps(vc, _mm_sub_ps(kf_sse_rot(vb[3],sign), vb[3]));
+
+            vs[0] = _mm_add_ps(va[0],va[2]);
+            vs[1] = _mm_sub_ps(va[0],va[2]);
+            vs[2] = _mm_add_ps(va[1],va[3]);
+            vs[3] = kf_sse_rot(_mm_sub_ps(va[1],va[3]),sign);
+            _mm_storeu_ps((float*)Fout, _mm_add_ps(vs[0],vs[2]));
+            _mm_storeu_ps((float*)(Fout+4*m), _mm_sub_ps(vs[0],vs[2]));
+            _mm_storeu_ps((float*)(Fout+2*m), _mm_add_ps(vs[1],vs[3]));
+            _mm_storeu_ps((float*)(Fout+6*m), _mm_sub_ps(vs[1],vs[3]));
+
+            vs[0] = _mm_add_ps(vb[0],vb[2]);
+            vs[1] = _mm_sub_ps(vb[0],vb[2]);
+            vs[2] = _mm_add_ps(vb[1],vb[3]);
+            vs[3] = kf_sse_rot(_mm_sub_ps(vb[1],vb[3]),sign);
+            _mm_storeu_ps((float*)(Fout+m), _mm_add_ps(vs[0],vs[2]));
+            _mm_storeu_ps((float*)(Fout+5*m), _mm_sub_ps(vs[0],vs[2]));
+            _mm_storeu_ps((float*)(Fout+3*m), _mm_add_ps(vs[1],vs[3]));
+            _mm_storeu_ps((float*)(Fout+7*m), _mm_sub_ps(vs[1],vs[3]));
+            Fout += 2;
+        }
+        if (!k)
+            return;
+    }
+#endif
+
+    do {
+        C_FIXDIV(Fout[0],8); C_FIXDIV(Fout[m],8); C_FIXDIV(Fout[2*m],8); C_FIXDIV(Fout[3*m],8);
+        C_FIXDIV(Fout[4*m],8); C_FIXDIV(Fout[5*m],8); C_FIXDIV(Fout[6*m],8); C_FIXDIV(Fout[7*m],8);
+
+        scratch[0] = Fout[0];
+        C_MUL(scratch[1], Fout[m], *tw1);
+        C_MUL(scratch[2], Fout[2*m], *tw2);
+        C_MUL(scratch[3], Fout[3*m], *tw3);
+        C_MUL(scratch[4], Fout[4*m], *tw4);
+        C_MUL(scratch[5], Fout[5*m], *tw5);
+        C_MUL(scratch[6], Fout[6*m], *tw6);
+        C_MUL(scratch[7], Fout[7*m], *tw7);
+        tw1 += fstride;
+        tw2 += fstride*2;
+        tw3 += fstride*3;
+        tw4 += fstride*4;
+        tw5 += fstride*5;
+        tw6 += fstride*6;
+        tw7 += fstride*7;
+
+        C_ADD( a[0], scratch[0], scratch[4] );
+        C_SUB( b[0], scratch[0], scratch[4] );
+        C_ADD( a[1], scratch[1], scratch[5] );
+        C_SUB( b[1], scratch[1], scratch[5] );
+        C_ADD( a[2], scratch[2], scratch[6] );
+        C_SUB( b[2], scratch[2], scratch[6] );
+        C_ADD( a[3], scratch[3], scratch[7] );
+        C_SUB( b[3], scratch[3], scratch[7] );
+
+        if(st->inverse) {
+            t = b[1];
+            b[1].r = S_MUL(t.r - t.i, c);
+            b[1].i = S_MUL(t.r + t.i, c);
+            t = b[2];
+            b[2].r = -t.i;
+            b[2].i = t.r;
+            t = b[3];
+            b[3].r = -S_MUL(t.r + t.i, c);
+            b[3].i = S_MUL(t.r - t.i, c);
+        }else{
+            t = b[1];
+            b[1].r = S_MUL(t.r + t.i, c);
+            b[1].i = S_MUL(t.i - t.r, c);
+            t = b[2];
+            b[2].r = t.i;
+            b[2].i = -t.r;
+            t = b[3];
+            b[3].r = S_MUL(t.i - t.r, c);
+            b[3].i = -S_MUL(t.r + t.i, c);
+        }
+
+        /* even outputs are the radix-4 DFT of a[], odd outputs of b[] */
+        C_ADD( s[0], a[0], a[2] );
+        C_SUB( s[1], a[0], a[2] );
+        C_ADD( s[2], a[1], a[3] );
+        C_SUB( s[3], a[1], a[3] );
+        C_ADD( Fout[0], s[0], s[2] );
+        C_SUB( Fout[4*m], s[0], s[2] );
+
+        C_ADD( a[0], b[0], b[2] );
+        C_SUB( a[1], b[0], b[2] );
+        C_ADD( a[2], b[1], b[3] );
+        C_SUB( a[3], b[1], b[3] );
+        C_ADD( Fout[m], a[0], a[2] );
+        C_SUB( Fout[5*m], a[0], a[2] );
+
+        if(st->inverse) {
+            Fout[2*m].r = s[1].r - s[3].i;
+            Fout[2*m].i = s[1].i + s[3].r;
+            Fout[6*m].r = s[1].r + s[3].i;
+            Fout[6*m].i = s[1].i - s[3].r;
+            Fout[3*m].r = a[1].r - a[3].i;
+            Fout[3*m].i = a[1].i + a[3].r;
+            Fout[7*m].r = a[1].r + a[3].i;
+            Fout[7*m].i = a[1].i - a[3].r;
+        }else{
+            Fout[2*m].r = s[1].r + s[3].i;
+            Fout[2*m].i = s[1].i - s[3].r;
+            Fout[6*m].r = s[1].r - s[3].i;
+            Fout[6*m].i = s[1].i + s[3].r;
+            Fout[3*m].r = a[1].r + a[3].i;
+            Fout[3*m].i = a[1].i - a[3].r;
+            Fout[7*m].r = a[1].r - a[3].i;
+            Fout[7*m].i = a[1].i + a[3].r;
+        }
+        ++Fout;
+    }while(--k);
+}
+
 /* perform the butterfly for one stage of a mixed radix FFT */
 static void kf_bfly_generic(
         kiss_fft_cpx * Fout,
@@ -250,7 +458,7 @@ void kf_work(
 #ifdef _OPENMP
     // use openmp extensions at the
     // top-level (not recursive)
-    if (fstride==1 && p<=5 && m!=1)
+    if (fstride==1 && (p<=5 || p==8) && m!=1)
     {
         int k;
 
@@ -265,6 +473,7 @@ void kf_work(
             case 3: kf_bfly3(Fout,fstride,st,m); break;
             case 4: kf_bfly4(Fout,fstride,st,m); break;
             case 5: kf_bfly5(Fout,fstride,st,m); break;
+            case 8: kf_bfly8(Fout,fstride,st,m); break;
             default: kf_bfly_generic(Fout,fstride,st,m,p); break;
         }
         return;
@@ -295,6 +504,7 @@ void kf_work(
         case 3: kf_bfly3(Fout,fstride,st,m); break;
         case 4: kf_bfly4(Fout,fstride,st,m); break;
         case 5: kf_bfly5(Fout,fstride,st,m); break;
+        case 8: kf_bfly8(Fout,fstride,st,m); break;
         default: kf_bfly_generic(Fout,fstride,st,m,p); break;
     }
 }
@@ -307,7 +517,39 @@ static
 void kf_factor(int n,int * facbuf)
 {
     int p=4;
+    int log2n=0;
     double floor_sqrt;
+
+    /* the power of two part of n is split into radix-8 stages, with one
+       radix-4 (or two, instead of an 8*2 pair) stage taking the remainder,
+       since kf_bfly8 needs fewer passes and multiplies than kf_bfly4/kf_bfly2 */
+    while (n > 0 && (n >> log2n) % 2 == 0)
+        ++log2n;
+    if (log2n >= 3) {
+        int n4 = 0;
+        switch (log2n % 3) {
+            case 1: n4 = 2; break;
+            case 2: n4 = 1; break;
+        }
+        log2n -= 2*n4;
+        while (n4--) {
+            p = 4;
+            n /= p;
+            *facbuf++ = p;
+            *facbuf++ = n;
+        }
+        while (log2n) {
+            p = 8;
+            log2n -= 3;
+            n /= p;
+            *facbuf++ = p;
+            *facbuf++ = n;
+        }
+        if (n == 1)
+            return;
+        p = 3;
+    }
+
     floor_sqrt = floor( sqrt((double)n) );
 
     /*factor out powers of 4, powers of 2, then any remaining primes */
@@ -327,6 +569,226 @@ void kf_factor(int n,int * facbuf)
     } while (n > 1);
 }
 
+#ifdef KISS_FFT_BLUESTEIN_THRESHOLD
+/*  returns the largest radix found by kf_factor */
+static
+int kf_largest_factor(const int * factors)
+{
+    int p=1;
+    do {
+        if (factors[0] > p)
+            p = factors[0];
+        factors += 2;
+    } while (factors[-1] > 1);
+    return p;
+}
+
+static
+int kf_bluestein_size(int nfft)
+{
+    int m=1;
+    while (m < 2*nfft-1)
+        m <<= 1;
+    return m;
+}
+
+/*  fills the chirp exp(-+ i*pi*n^2/nfft) and the spectrum of its conjugate,
+    wrapped around for negative n, scaled by 1/bluestein_nfft so that
+    the inverse transform of the product needs no extra pass */
+static
+void kf_bluestein_init(kiss_fft_cfg st)
+{
+    const double pi=3.141592653589793238462643383279502884197169399375105820974944;
+    const int n = st->nfft;
+    const int m = st->bluestein_nfft;
+    kiss_fft_cpx * chirp = st->twiddles + n;
+    kiss_fft_cpx * filter = chirp + n;
+    kiss_fft_cfg sub = (kiss_fft_cfg)(filter + m);
+    const kiss_fft_scalar norm = (kiss_fft_scalar)(1.0 / m);
+    int i;
+
+    for (i=0;i<n;++i) {
+        /* n^2 mod 2*nfft keeps the phase argument small and exact */
+        double phase = -pi * (double)(((long long)i * i) % (2LL * n)) / n;
+        if (st->inverse)
+            phase *= -1;
+        kf_cexp(chirp+i, phase);
+    }
+
+    memset(filter,0,sizeof(kiss_fft_cpx)*m);
+    for (i=0;i<n;++i) {
+        filter[i].r = chirp[i].r;
+        filter[i].i = -chirp[i].i;
+        if (i)
+            filter[m-i] = filter[i];
+    }
+    kiss_fft(sub,filter,filter);
+    for (i=0;i<m;++i)
+        C_MULBYSCALAR(filter[i],norm);
+}
+
+/*  X[k] = chirp[k] * sum(x[j] * chirp[j] * conj(chirp[k-j]))
+    The convolution runs on the bluestein_nfft power of two FFT,
+    its inverse is taken as conj(fft(conj(.))) to reuse the same state */
+static
+void kf_bluestein(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int in_stride)
+{
+    const int n = st->nfft;
+    const int m = st->bluestein_nfft;
+    const kiss_fft_cpx * chirp = st->twiddles + n;
+    const kiss_fft_cpx * filter = chirp + n;
+    const kiss_fft_cfg sub = (kiss_fft_cfg)(filter + m);
+    kiss_fft_cpx * a;
+    kiss_fft_cpx * b;
+    kiss_fft_cpx t;
+    int i;
+
+    a = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*2*m);
+    if (a == NULL){
+        KISS_FFT_ERROR("Memory allocation failed.");
+        return;
+    }
+    b = a + m;
+
+    for (i=0;i<n;++i) {
+        C_MUL(a[i],*fin,chirp[i]);
+        fin += in_stride;
+    }
+    memset(a+n,0,sizeof(kiss_fft_cpx)*(m-n));
+
+    kiss_fft(sub,a,b);
+    for (i=0;i<m;++i) {
+        C_MUL(t,b[i],filter[i]);
+        a[i].r = t.r;
+        a[i].i = -t.i;
+    }
+    kiss_fft(sub,a,b);
+
+    for (i=0;i<n;++i) {
+        t.r = b[i].r;
+        t.i = -b[i].i;
+        C_MUL(fout[i],t,chirp[i]);
+    }
+    KISS_FFT_TMP_FREE(a);
+}
+#endif
+
+#ifdef KISS_FFT_FOURSTEP_THRESHOLD
+/* columns moved per blocked transpose, wide enough that each row visited
+   (usually a different page) delivers several cache lines */
+#define KF_FOURSTEP_BLOCK 64
+
+/* twiddles advanced by the recurrence between two reads of the table */
+#define KF_FOURSTEP_REFRESH 8
+
+/*  largest divisor of n not above sqrt(n) */
+static
+int kf_fourstep_split(int n)
+{
+    int n1 = (int)floor( sqrt((double)n) );
+    while (n % n1)
+        --n1;
+    return n1;
+}
+
+/*  X[k1 + n1*k2] = sum over j2 of W(n2)^(j2*k2) * W(nfft)^(j2*k1) *
+                    sum over j1 of W(n1)^(j1*k1) * x[n2*j1 + j2]
+
+    The columns of x are gathered KF_FOURSTEP_BLOCK at a time into
+    contiguous rows, so both passes run unit-stride n1 and n2 point FFTs
+    on data that stays in cache. With OpenMP the blocks of each pass are
+    spread over the threads. The whole input is consumed by the first pass,
+    so fin may be equal to fout */
+static
+void kf_fourstep(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int in_stride)
+{
+    const int n = st->nfft;
+    const int n1 = st->fourstep_n1;
+    const int n2 = n / n1;
+    const kiss_fft_cfg sub1 = (kiss_fft_cfg)(st->twiddles + n);
+    const kiss_fft_cfg sub2 = (kiss_fft_cfg)((char*)sub1 + st->fourstep_offset);
+    const size_t rowlen = (size_t)KF_FOURSTEP_BLOCK * (n1 > n2 ? n1 : n2);
+    int nthreads = 1;
+    kiss_fft_cpx * tmpbuf;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    tmpbuf = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*(n + 2*rowlen*nthreads));
+    if (tmpbuf == NULL){
+        KISS_FFT_ERROR("Memory allocation failed.");
+        return;
+    }
+
+#ifdef _OPENMP
+#   pragma omp parallel num_threads(nthreads)
+#endif
+    {
+        int c,b,w,j,k;
+        kiss_fft_cpx * rows = tmpbuf + n;
+        kiss_fft_cpx * frows;
+#ifdef _OPENMP
+        rows += 2*rowlen*omp_get_thread_num();
+#endif
+        frows = rows + rowlen;
+
+        /* n2 FFTs of n1 points over the columns, multiplied by W(nfft)^(j2*k1),
+           stored as rows tmpbuf[j2*n1 + k1] */
+#ifdef _OPENMP
+#       pragma omp for schedule(static)
+#endif
+        for (c=0;c<n2;c+=KF_FOURSTEP_BLOCK) {
+            w = n2 - c < KF_FOURSTEP_BLOCK ? n2 - c : KF_FOURSTEP_BLOCK;
+            for (j=0;j<n1;++j) {
+                const kiss_fft_cpx * src = fin + ((size_t)j*n2 + c)*in_stride;
+                for (b=0;b<w;++b)
+                    rows[b*n1 + j] = src[b*in_stride];
+            }
+            for (b=0;b<w;++b) {
+                kiss_fft_cpx * dst = tmpbuf + (size_t)(c+b)*n1;
+                const kiss_fft_cpx step = st->twiddles[c+b];
+                kiss_fft_cpx tw = step, t;
+                kiss_fft(sub1,rows + b*n1,dst);
+                /* the table is read every KF_FOURSTEP_REFRESH twiddles,
+                   the ones in between are advanced by W(nfft)^j2: a short
+                   recurrence keeps the round-off at the table's level */
+                for (k=1;k<n1;++k) {
+                    if (k % KF_FOURSTEP_REFRESH == 1) {
+                        tw = st->twiddles[(size_t)(c+b)*k];
+                    }else{
+                        t = tw;
+                        C_MUL(tw,t,step);
+                    }
+                    t = dst[k];
+                    C_MUL(dst[k],t,tw);
+                }
+            }
+        }
+
+        /* n1 FFTs of n2 points over the columns of the rows above */
+#ifdef _OPENMP
+#       pragma omp for schedule(static)
+#endif
+        for (c=0;c<n1;c+=KF_FOURSTEP_BLOCK) {
+            w = n1 - c < KF_FOURSTEP_BLOCK ? n1 - c : KF_FOURSTEP_BLOCK;
+            for (j=0;j<n2;++j) {
+                const kiss_fft_cpx * src = tmpbuf + (size_t)j*n1 + c;
+                for (b=0;b<w;++b)
+                    rows[b*n2 + j] = src[b];
+            }
+            for (b=0;b<w;++b)
+                kiss_fft(sub2,rows + b*n2,frows + b*n2);
+            for (k=0;k<n2;++k) {
+                kiss_fft_cpx * dst = fout + (size_t)k*n1 + c;
+                for (b=0;b<w;++b)
+                    dst[b] = frows[b*n2 + k];
+            }
+        }
+    }
+    KISS_FFT_TMP_FREE(tmpbuf);
+}
+#endif
+
 /*
  *
  * User-callable function to allocate all necessary storage space for the fft.
@@ -339,9 +801,38 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
     KISS_FFT_ALIGN_CHECK(mem)
 
     kiss_fft_cfg st=NULL;
+    int factors[2*MAXFACTORS];
+    int bluestein_nfft=0;
+    int fourstep_n1=0;
+    int fourstep_offset=0;
     size_t memneeded = KISS_FFT_ALIGN_SIZE_UP(sizeof(struct kiss_fft_state)
         + sizeof(kiss_fft_cpx)*(nfft-1)); /* twiddle factors*/
 
+    kf_factor(nfft,factors);
+#ifdef KISS_FFT_BLUESTEIN_THRESHOLD
+    if (nfft > 1 && kf_largest_factor(factors) > KISS_FFT_BLUESTEIN_THRESHOLD) {
+        size_t subsize = 0;
+        bluestein_nfft = kf_bluestein_size(nfft);
+        kiss_fft_alloc(bluestein_nfft, 0, NULL, &subsize);
+        memneeded += sizeof(kiss_fft_cpx)*(nfft + bluestein_nfft) /* chirp, filter */
+            + subsize;
+    }
+#endif
+#ifdef KISS_FFT_FOURSTEP_THRESHOLD
+    if (!bluestein_nfft && nfft >= KISS_FFT_FOURSTEP_THRESHOLD) {
+        size_t subsize1 = 0, subsize2 = 0;
+        fourstep_n1 = kf_fourstep_split(nfft);
+        if (fourstep_n1 >= 16) {
+            kiss_fft_alloc(fourstep_n1, inverse_fft, NULL, &subsize1);
+            kiss_fft_alloc(nfft / fourstep_n1, inverse_fft, NULL, &subsize2);
+            memneeded += subsize1 + subsize2;
+            fourstep_offset = (int)subsize1;
+        }else{
+            fourstep_n1 = 0;
+        }
+    }
+#endif
+
     if ( lenmem==NULL ) {
         st = ( kiss_fft_cfg)KISS_FFT_MALLOC( memneeded );
     }else{
@@ -353,6 +844,9 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
         int i;
         st->nfft=nfft;
         st->inverse = inverse_fft;
+        st->bluestein_nfft = bluestein_nfft;
+        st->fourstep_n1 = fourstep_n1;
+        st->fourstep_offset = fourstep_offset;
 
         for (i=0;i<nfft;++i) {
             const double pi=3.141592653589793238462643383279502884197169399375105820974944;
@@ -362,7 +856,24 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
             kf_cexp(st->twiddles+i, phase );
         }
 
-        kf_factor(nfft,st->factors);
+        memcpy(st->factors,factors,sizeof(factors));
+#ifdef KISS_FFT_BLUESTEIN_THRESHOLD
+        if (bluestein_nfft) {
+            kiss_fft_cpx * sub = st->twiddles + nfft + nfft + bluestein_nfft;
+            size_t subsize = memneeded - ((char*)sub - (char*)st);
+            kiss_fft_alloc(bluestein_nfft, 0, sub, &subsize);
+            kf_bluestein_init(st);
+        }
+#endif
+#ifdef KISS_FFT_FOURSTEP_THRESHOLD
+        if (fourstep_n1) {
+            char * sub = (char*)(st->twiddles + nfft);
+            size_t subsize = memneeded - (sub - (char*)st);
+            kiss_fft_alloc(fourstep_n1, inverse_fft, sub, &subsize);
+            subsize = memneeded - (sub + fourstep_offset - (char*)st);
+            kiss_fft_alloc(nfft / fourstep_n1, inverse_fft, sub + fourstep_offset, &subsize);
+        }
+#endif
     }
     return st;
 }
@@ -370,6 +881,18 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
 
 void kiss_fft_stride(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int in_stride)
 {
+#ifdef KISS_FFT_BLUESTEIN_THRESHOLD
+    if (st->bluestein_nfft) {
+        kf_bluestein(st,fin,fout,in_stride);
+        return;
+    }
+#endif
+#ifdef KISS_FFT_FOURSTEP_THRESHOLD
+    if (st->fourstep_n1) {
+        kf_fourstep(st,fin,fout,in_stride);
+        return;
+    }
+#endif
     if (fin == fout) {
         //NOTE: this is not really an in-place FFT algorithm.
         //It just performs an out-of-place FFT into a temp buffer
@@ -81,6 +81,7 @@ extern "C" {
 # ifndef kiss_fft_scalar
 /*  default is float */
 #   define kiss_fft_scalar float
+#   define KISS_FFT_FLOAT_SCALAR
 # endif
 #endif
 
@@ -98,7 +98,27 @@ void kiss_fftr(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,kiss_fft_cpx *fr
     freqdata[ncfft].i = freqdata[0].i = 0;
 #endif
 
-    for ( k=1;k <= ncfft/2 ; ++k ) {
+    k=1;
+#ifdef KISS_FFT_SSE
+    {
+        /* bins k, k+1 and their mirrors ncfft-k, ncfft-k-1 at once */
+        const __m128 conj = _mm_set_ps(-0.f,0.f,-0.f,0.f);
+        const __m128 half = _mm_set1_ps(.5f);
+        for ( ; k+1 <= ncfft/2 ; k += 2 ) {
+            __m128 vfpk = _mm_loadu_ps((float*)(st->tmpbuf+k));
+            __m128 vfpnk = _mm_loadu_ps((float*)(st->tmpbuf+ncfft-k-1));
+            __m128 vf1k,vf2k,vtw;
+            vfpnk = _mm_xor_ps( _mm_shuffle_ps(vfpnk,vfpnk,_MM_SHUFFLE(1,0,3,2)), conj );
+            vf1k = _mm_add_ps(vfpk,vfpnk);
+            vf2k = _mm_sub_ps(vfpk,vfpnk);
+            vtw = kf_sse_cmul( vf2k, _mm_loadu_ps((float*)(st->super_twiddles+k-1)) );
+            _mm_storeu_ps((float*)(freqdata+k), _mm_mul_ps(half, _mm_add_ps(vf1k,vtw)));
+            vtw = _mm_xor_ps( _mm_mul_ps(half, _mm_sub_ps(vf1k,vtw)), conj );
+            _mm_storeu_ps((float*)(freqdata+ncfft-k-1), _mm_shuffle_ps(vtw,vtw,_MM_SHUFFLE(1,0,3,2)));
+        }
+    }
+#endif
+    for ( ;k <= ncfft/2 ; ++k ) {
         fpk    = st->tmpbuf[k];
         fpnk.r =   st->tmpbuf[ncfft-k].r;
         fpnk.i = - st->tmpbuf[ncfft-k].i;
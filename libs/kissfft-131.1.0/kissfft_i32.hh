@@ -1,7 +1,9 @@
 #ifndef KISSFFT_I32_CLASS_HH
 #define KISSFFT_I32_CLASS_HH
 
+#include <cmath>
 #include <complex>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -21,11 +23,12 @@ class kissfft_i32
 private:
 
     using scalar_type = int32_t;
-    using cpx_type    = complex<int32_t>;
+    using cpx_type    = std::complex<int32_t>;
 
     scalar_type _scale_factor;
     std::size_t _nfft;
     bool _inverse;
+    bool _stage_scaling;
     std::vector<cpx_type> _twiddles;
     std::vector<std::size_t> _stageRadix;
     std::vector<std::size_t> _stageRemainder;
@@ -33,15 +36,20 @@ private:
 public:
 
     // scale_factor: upscale twiddle-factors otherwise they lie between 0..1 (out of range for integer) --> fixed point math
-    kissfft_i32(const std::size_t nfft, const bool inverse, const double scale_factor = 1024.0)
-            : _scale_factor(scalar_type(scale_factor)), _nfft(nfft), _inverse(inverse)
+    //               (up to 2^30, the products with the twiddle-factors are computed in 64 bit)
+    // stage_scaling: divide the input of every stage by its radix, as kissfft with FIXED_POINT does,
+    //                so that the result is the DFT divided by nfft and cannot overflow
+    kissfft_i32(const std::size_t nfft, const bool inverse, const double scale_factor = 1024.0,
+                const bool stage_scaling = false)
+            : _scale_factor(scalar_type(scale_factor)), _nfft(nfft), _inverse(inverse), _stage_scaling(stage_scaling)
     {
         // fill twiddle factors
         _twiddles.resize(_nfft);
-        const double phinc = (_inverse ? 2 : -2) * acos(-1.0) / _nfft;
+        const double phinc = (_inverse ? 2 : -2) * std::acos(-1.0) / _nfft;
         for (std::size_t i = 0; i < _nfft; ++i)
         {
-            _twiddles[i] = scale_factor * exp(complex<double>(0, i * phinc));
+            _twiddles[i] = cpx_type(scalar_type(std::floor(scale_factor * std::cos(i * phinc) + .5)),
+                                    scalar_type(std::floor(scale_factor * std::sin(i * phinc) + .5)));
         }
         //factorize
         //start factoring out 4's, then 2's, then 3,5,7,9,...
@@ -76,7 +84,8 @@ public:
     /// The size of the passed arrays must be passed in the constructor.
     /// The sum of the squares of the absolute values in the @c dst
     /// array will be @c N times the sum of the squares of the absolute
-    /// values in the @c src array, where @c N is the size of the array.
+    /// values in the @c src array, where @c N is the size of the array
+    /// (or @c 1/N times with stage_scaling).
     /// In other words, the l_2 norm of the resulting array will be
     /// @c sqrt(N) times as big as the l_2 norm of the input array.
     /// This is also the case when the inverse flag is set in the
@@ -140,13 +149,33 @@ public:
 
 private:
 
+    // a * b / _scale_factor
+    cpx_type _mul(const cpx_type &a, const cpx_type &b) const
+    {
+        return cpx_type(scalar_type(((int64_t)a.real() * b.real() - (int64_t)a.imag() * b.imag()) / _scale_factor),
+                        scalar_type(((int64_t)a.real() * b.imag() + (int64_t)a.imag() * b.real()) / _scale_factor));
+    }
+
+    // a * b / _scale_factor, b real
+    scalar_type _mul(const scalar_type a, const scalar_type b) const
+    {
+        return scalar_type((int64_t)a * b / _scale_factor);
+    }
+
+    // input of a butterfly of radix p
+    cpx_type _in(const cpx_type &a, const scalar_type p) const
+    {
+        return _stage_scaling ? a / p : a;
+    }
+
     void kf_bfly2(cpx_type *const Fout, const size_t fstride, const std::size_t m) const
     {
         for (std::size_t k = 0; k < m; ++k)
         {
-            const cpx_type t = (Fout[m + k] * _twiddles[k * fstride]) / _scale_factor;
-            Fout[m + k] = Fout[k] - t;
-            Fout[k] += t;
+            const cpx_type t = _mul(_in(Fout[m + k], 2), _twiddles[k * fstride]);
+            const cpx_type f = _in(Fout[k], 2);
+            Fout[m + k] = f - t;
+            Fout[k] = f + t;
         }
     }
 
@@ -162,8 +191,9 @@ private:
 
         do
         {
-            scratch[1] = (Fout[m] * *tw1) / _scale_factor;
-            scratch[2] = (Fout[m2] * *tw2) / _scale_factor;
+            Fout[0] = _in(Fout[0], 3);
+            scratch[1] = _mul(_in(Fout[m], 3), *tw1);
+            scratch[2] = _mul(_in(Fout[m2], 3), *tw2);
 
             scratch[3] = scratch[1] + scratch[2];
             scratch[0] = scratch[1] - scratch[2];
@@ -171,8 +201,7 @@ private:
             tw2 += fstride * 2;
 
             Fout[m] = Fout[0] - (scratch[3] / 2);
-            scratch[0] *= epi3.imag();
-            scratch[0] /= _scale_factor;
+            scratch[0] = cpx_type(_mul(scratch[0].real(), epi3.imag()), _mul(scratch[0].imag(), epi3.imag()));
 
             Fout[0] += scratch[3];
 
@@ -190,9 +219,10 @@ private:
 
         for (std::size_t k = 0; k < m; ++k)
         {
-            scratch[0] = (Fout[k + m] * _twiddles[k * fstride]) / _scale_factor;
-            scratch[1] = (Fout[k + 2 * m] * _twiddles[k * fstride * 2]) / _scale_factor;
-            scratch[2] = (Fout[k + 3 * m] * _twiddles[k * fstride * 3]) / _scale_factor;
+            Fout[k] = _in(Fout[k], 4);
+            scratch[0] = _mul(_in(Fout[k + m], 4), _twiddles[k * fstride]);
+            scratch[1] = _mul(_in(Fout[k + 2 * m], 4), _twiddles[k * fstride * 2]);
+            scratch[2] = _mul(_in(Fout[k + 3 * m], 4), _twiddles[k * fstride * 3]);
             scratch[5] = Fout[k] - scratch[1];
 
             Fout[k] += scratch[1];
@@ -223,12 +253,12 @@ private:
 
         for (std::size_t u = 0; u < m; ++u)
         {
-            scratch[0] = *Fout0;
+            scratch[0] = *Fout0 = _in(*Fout0, 5);
 
-            scratch[1] = (*Fout1 * _twiddles[u * fstride]) / _scale_factor;
-            scratch[2] = (*Fout2 * _twiddles[2 * u * fstride]) / _scale_factor;
-            scratch[3] = (*Fout3 * _twiddles[3 * u * fstride]) / _scale_factor;
-            scratch[4] = (*Fout4 * _twiddles[4 * u * fstride]) / _scale_factor;
+            scratch[1] = _mul(_in(*Fout1, 5), _twiddles[u * fstride]);
+            scratch[2] = _mul(_in(*Fout2, 5), _twiddles[2 * u * fstride]);
+            scratch[3] = _mul(_in(*Fout3, 5), _twiddles[3 * u * fstride]);
+            scratch[4] = _mul(_in(*Fout4, 5), _twiddles[4 * u * fstride]);
 
             scratch[7] = scratch[1] + scratch[4];
             scratch[10] = scratch[1] - scratch[4];
@@ -238,24 +268,24 @@ private:
             *Fout0 += scratch[7];
             *Fout0 += scratch[8];
 
-            scratch[5] = scratch[0] + (cpx_type(
-                    scratch[7].real() * ya.real() + scratch[8].real() * yb.real(),
-                    scratch[7].imag() * ya.real() + scratch[8].imag() * yb.real() ) / _scale_factor);
+            scratch[5] = scratch[0] + cpx_type(
+                    _mul(scratch[7].real(), ya.real()) + _mul(scratch[8].real(), yb.real()),
+                    _mul(scratch[7].imag(), ya.real()) + _mul(scratch[8].imag(), yb.real()));
 
             scratch[6] = cpx_type(
-                    scratch[10].imag() * ya.imag() + scratch[9].imag() * yb.imag(),
-                    -scratch[10].real() * ya.imag() - scratch[9].real() * yb.imag() ) / _scale_factor;
+                    _mul(scratch[10].imag(), ya.imag()) + _mul(scratch[9].imag(), yb.imag()),
+                    -_mul(scratch[10].real(), ya.imag()) - _mul(scratch[9].real(), yb.imag()));
 
             *Fout1 = scratch[5] - scratch[6];
             *Fout4 = scratch[5] + scratch[6];
 
-            scratch[11] = scratch[0] + (cpx_type(
-                    scratch[7].real() * yb.real() + scratch[8].real() * ya.real(),
-                    scratch[7].imag() * yb.real() + scratch[8].imag() * ya.real() ) / _scale_factor);
+            scratch[11] = scratch[0] + cpx_type(
+                    _mul(scratch[7].real(), yb.real()) + _mul(scratch[8].real(), ya.real()),
+                    _mul(scratch[7].imag(), yb.real()) + _mul(scratch[8].imag(), ya.real()));
 
             scratch[12] = cpx_type(
-                    -scratch[10].imag() * yb.imag() + scratch[9].imag() * ya.imag(),
-                    scratch[10].real() * yb.imag() - scratch[9].real() * ya.imag() ) / _scale_factor;
+                    -_mul(scratch[10].imag(), yb.imag()) + _mul(scratch[9].imag(), ya.imag()),
+                    _mul(scratch[10].real(), yb.imag()) - _mul(scratch[9].real(), ya.imag()));
 
             *Fout2 = scratch[11] + scratch[12];
             *Fout3 = scratch[11] - scratch[12];
@@ -272,14 +302,14 @@ private:
     void kf_bfly_generic(cpx_type * const Fout, const size_t fstride, const std::size_t m, const std::size_t p) const
     {
         const cpx_type *twiddles = &_twiddles[0];
-        cpx_type scratchbuf[p];
+        std::vector<cpx_type> scratchbuf(p);
 
         for (std::size_t u = 0; u < m; ++u)
         {
             std::size_t k = u;
             for (std::size_t q1 = 0; q1 < p; ++q1)
             {
-                scratchbuf[q1] = Fout[k];
+                scratchbuf[q1] = _in(Fout[k], scalar_type(p));
                 k += m;
             }
 
@@ -293,7 +323,7 @@ private:
                     twidx += fstride * k;
                     if (twidx >= _nfft)
                         twidx -= _nfft;
-                    Fout[k] += (scratchbuf[q] * twiddles[twidx]) / _scale_factor;
+                    Fout[k] += _mul(scratchbuf[q], twiddles[twidx]);
                 }
                 k += m;
             }
@@ -0,0 +1,62 @@
+#include "Batch.h"
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+template<typename T>
+spectrum::BasicBatch<T>::BasicBatch(int NFFT, int timeScale, Backend backend, int threads)
+    : NFFT(NFFT),
+    timeScale(timeScale),
+    backend(backend),
+    pool(threads),
+    ahead(0)
+{
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        spectrum::terminate(BAD_NFFT);
+
+    if (timeScale < 1 || timeScale > 1000 )
+        spectrum::terminate(BAD_TIMESCALE);
+};
+
+template<typename T>
+spectrum::BasicBatch<T>::~BasicBatch() {};
+
+template<typename T>
+void
+spectrum::BasicBatch<T>::run(const std::vector<std::string>& paths, callback_t callback) {
+    for (int i = 0; i < (int)paths.size(); i++) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->decoded.wait(lock, [this]() { 
+                return this->ahead < 2 * this->pool.getThreads(); 
+            });
+            this->ahead++;
+        }
+        
+        /* Reading while the workers decode and analyze the previous files, 
+         * a file that cannot be opened is empty */
+        std::ifstream file(paths[i], std::ios::binary);
+        std::shared_ptr<std::vector<uint8_t>> data(new std::vector<uint8_t>(
+                (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+        
+        this->pool.submit([this, i, &paths, callback, data]() {
+            BasicProcessing<T> processing(this->NFFT, *data, paths[i].c_str(), this->backend);
+            
+            /* The memory of the file is given back before the analysis */
+            data->clear();
+            data->shrink_to_fit();
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->ahead--;
+            }
+            this->decoded.notify_one();
+            
+            processing.pFFT(this->timeScale);
+            callback(i, paths[i], processing);
+        });
+    }
+    this->pool.wait();
+};
+
+template class spectrum::BasicBatch<float>;
+template class spectrum::BasicBatch<double>;
@@ -0,0 +1,8 @@
+#include "Common.h"
+#include <cstdlib>
+
+void 
+spectrum::terminate(const char* exitMessage) {
+    std::cerr << "Error : " << exitMessage << std::endl;
+    return exit(1);
+};
@@ -0,0 +1,152 @@
+#include "ConstantQ.h"
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <tuple>
+
+/* Spectral kernel values below this part of the largest one are dropped */
+#define CQ_THRESHOLD 0.005
+/* The number of kernels kept for the next objects, the least recently 
+ * used one is dropped (the objects using it keep it) */
+#define CQ_CACHE 8
+
+template<typename T>
+spectrum::ConstantQ<T>::ConstantQ(int sampleRate, float fmin, float fmax, int binsPerOctave)
+    : kernel(_kernel(sampleRate, fmin, fmax, binsPerOctave)),
+    plan(kernel->NFFT),
+    freq(kernel->NFFT / 2 + 1) {};
+
+template<typename T>
+spectrum::ConstantQ<T>::~ConstantQ() {};
+
+template<typename T>
+bool
+spectrum::ConstantQ<T>::isValid() {
+    return this->plan.isValid() && !this->kernel->frequencies.empty();
+};
+
+template<typename T>
+int
+spectrum::ConstantQ<T>::getNFFT() {
+    return this->kernel->NFFT;
+};
+
+template<typename T>
+int
+spectrum::ConstantQ<T>::getSize() {
+    return this->kernel->frequencies.size();
+};
+
+template<typename T>
+float
+spectrum::ConstantQ<T>::getFrequency(int k) {
+    return this->kernel->frequencies[k];
+};
+
+template<typename T>
+void
+spectrum::ConstantQ<T>::transform(const T* samples, cpx_t* values) {
+    const Kernel& K = *this->kernel;
+    const cpx_t* X = this->freq.data();
+
+    this->plan.fftr(samples, this->freq.data());
+    
+    /* X[k] = sum of FFT[j] * conj(kernel[k][j]) / NFFT (Parseval) */
+    for (int k = 0; k < (int)K.frequencies.size(); k++) {
+        const cpx_t* w = K.weights.data() + K.offset[k];
+        const cpx_t* x = X + K.start[k];
+        const int n = K.offset[k + 1] - K.offset[k];
+        T r = 0, i = 0;
+
+        for (int j = 0; j < n; j++) {
+            r += x[j].r * w[j].r - x[j].i * w[j].i;
+            i += x[j].r * w[j].i + x[j].i * w[j].r;
+        }
+        values[k].r = r;
+        values[k].i = i;
+    }
+};
+
+template<typename T>
+std::shared_ptr<const typename spectrum::ConstantQ<T>::Kernel>
+spectrum::ConstantQ<T>::_kernel(int sampleRate, float fmin, float fmax, int binsPerOctave) {
+    typedef std::tuple<int, float, float, int> key_t;
+    static std::list<std::pair<key_t, std::shared_ptr<const Kernel>>> cache;
+    static std::mutex mutex;
+    
+    const key_t key = std::make_tuple(sampleRate, fmin, fmax, binsPerOctave);
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    /* The most recently used kernels are the first ones */
+    for (auto i = cache.begin(); i != cache.end(); i++) {
+        if (i->first == key) {
+            cache.splice(cache.begin(), cache, i);
+            return cache.front().second;
+        }
+    }
+
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    const double Q = 1 / (std::pow(2.0, 1.0 / binsPerOctave) - 1);
+    const int K = (int)std::floor(binsPerOctave * std::log2((double)fmax / fmin)) + 1;
+    std::shared_ptr<Kernel> kernel(new Kernel());
+    
+    /* The longest kernel is the one of fmin */
+    kernel->NFFT = 1;
+    while (kernel->NFFT < std::ceil(Q * sampleRate / fmin))
+        kernel->NFFT *= 2;
+    
+    const int NFFT = kernel->NFFT;
+    std::vector<kiss_fft_f64_cpx> temporal(NFFT), spectral(NFFT);
+    kiss_fft_f64_cfg cfg = kiss_fft_f64_alloc(NFFT, false, 0, 0);
+    
+    kernel->offset.push_back(0);
+    for (int k = 0; k < K && cfg; k++) {
+        const double f = fmin * std::pow(2.0, (double)k / binsPerOctave);
+        const int N = (int)std::ceil(Q * sampleRate / f);
+        
+        /* Hamming windowed sinusoid of Q periods divided by its length, 
+         * centred in the FFT window */
+        std::fill(temporal.begin(), temporal.end(), kiss_fft_f64_cpx{0, 0});
+        for (int n = 0; n < N; n++) {
+            const double w = (0.54 - 0.46 * std::cos(2 * pi * n / N)) / N;
+            temporal[(NFFT - N) / 2 + n].r = w * std::cos(2 * pi * Q * n / N);
+            temporal[(NFFT - N) / 2 + n].i = w * std::sin(2 * pi * Q * n / N);
+        }
+        kiss_fft_f64(cfg, temporal.data(), spectral.data());
+        
+        /* The contiguous range of the positive frequencies above the threshold */
+        double peak = 0;
+        for (int j = 0; j <= NFFT / 2; j++)
+            peak = std::max(peak, std::hypot(spectral[j].r, spectral[j].i));
+        
+        int first = 0, last = NFFT / 2;
+        while (first < last && std::hypot(spectral[first].r, spectral[first].i) < CQ_THRESHOLD * peak)
+            first++;
+        while (last > first && std::hypot(spectral[last].r, spectral[last].i) < CQ_THRESHOLD * peak)
+            last--;
+        
+        kernel->frequencies.push_back(f);
+        kernel->start.push_back(first);
+        for (int j = first; j <= last; j++) {
+            cpx_t w;
+            w.r = (T)(spectral[j].r / NFFT);
+            w.i = (T)(-spectral[j].i / NFFT);
+            kernel->weights.push_back(w);
+        }
+        kernel->offset.push_back(kernel->weights.size());
+    }
+    
+    /* Without the FFT the kernel has no bins (see isValid()), 
+     * it is not kept */
+    if (!cfg)
+        return kernel;
+    kiss_fft_free(cfg);
+    
+    cache.emplace_front(key, kernel);
+    if (cache.size() > CQ_CACHE)
+        cache.pop_back();
+    return kernel;
+};
+
+template class spectrum::ConstantQ<float>;
+template class spectrum::ConstantQ<double>;
@@ -0,0 +1,101 @@
+#include "CrossCorrelation.h"
+#include <cmath>
+#include <algorithm>
+
+/* Cross-spectrum values of a smaller magnitude are dropped by GCC-PHAT */
+#define PHAT_FLOOR 1e-20
+
+template<typename T>
+spectrum::CrossCorrelation<T>::CrossCorrelation(int NFFT, int channels, bool phat, int maxLag)
+    : NFFT(NFFT),
+    phat(phat),
+    maxLag(maxLag > 0 ? std::min(maxLag, NFFT - 1) : NFFT / 2 - 1),
+    plan(NFFT),
+    padded(2 * NFFT),
+    frames(2 * NFFT),
+    spectra(channels * (NFFT + 1)),
+    cross(NFFT + 1),
+    correlation(2 * NFFT)
+{
+    for (int a = 0; a < channels; a++) {
+        for (int b = a + 1; b < channels; b++) {
+            this->first.push_back(a);
+            this->second.push_back(b);
+        }
+    }
+};
+
+template<typename T>
+spectrum::CrossCorrelation<T>::~CrossCorrelation() {};
+
+template<typename T>
+bool
+spectrum::CrossCorrelation<T>::isValid() {
+    return this->plan.isValid() && this->padded.isValid();
+};
+
+template<typename T>
+int
+spectrum::CrossCorrelation<T>::getPairs() {
+    return this->first.size();
+};
+
+template<typename T>
+int
+spectrum::CrossCorrelation<T>::getMaxLag() {
+    return this->maxLag;
+};
+
+template<typename T>
+void
+spectrum::CrossCorrelation<T>::delays(const cpx_t* const* spectra, T* lags) {
+    const int S = this->NFFT + 1;
+    const int N = 2 * this->NFFT;
+    cpx_t* G = this->cross.data();
+    const T* r = this->correlation.data();
+    
+    /* The frames of every channel followed by NFFT zeros (the scale, 
+     * NFFT, is the same for all the channels) */
+    for (int c = 0; c < (int)this->spectra.size() / S; c++) {
+        this->plan.fftri(spectra[c], this->frames.data());
+        std::fill(this->frames.begin() + this->NFFT, this->frames.end(), 0);
+        this->padded.fftr(this->frames.data(), this->spectra.data() + c * S);
+    }
+    
+    for (int p = 0; p < this->getPairs(); p++) {
+        const cpx_t* Xa = this->spectra.data() + this->first[p] * S;
+        const cpx_t* Xb = this->spectra.data() + this->second[p] * S;
+        
+        /* conj(Xa) * Xb */
+        for (int k = 0; k < S; k++) {
+            G[k].r = Xa[k].r * Xb[k].r + Xa[k].i * Xb[k].i;
+            G[k].i = Xa[k].r * Xb[k].i - Xa[k].i * Xb[k].r;
+        }
+        if (this->phat) {
+            for (int k = 0; k < S; k++) {
+                const T m = std::sqrt(G[k].r * G[k].r + G[k].i * G[k].i);
+                const T w = m > (T)PHAT_FLOOR ? 1 / m : 0;
+                G[k].r *= w;
+                G[k].i *= w;
+            }
+        }
+        this->padded.fftri(G, this->correlation.data());
+        
+        /* The lag t is at r[t], the lag -t at r[2 * NFFT - t] */
+        int best = 0;
+        for (int t = -this->maxLag; t <= this->maxLag; t++) {
+            if (r[(t + N) % N] > r[(best + N) % N])
+                best = t;
+        }
+        
+        const T y0 = r[(best - 1 + N) % N];
+        const T y1 = r[(best + N) % N];
+        const T y2 = r[(best + 1 + N) % N];
+        const T d = y0 - 2 * y1 + y2;
+        
+        lags[p] = best + (d < 0 ? (T)0.5 * (y0 - y2) / d : 0);
+    }
+};
+
+template class spectrum::CrossCorrelation<float>;
+template class spectrum::CrossCorrelation<double>;
@@ -0,0 +1,105 @@
+#include "Decimator.h"
+#include "Simd.h"
+#include <cmath>
+#include <algorithm>
+
+/* Filter taps per unit of decimation, Blackman window:
+ * the transition band is about 5.5 / DECIMATOR_TAPS of the decimated rate,
+ * the stopband attenuation about 74 dB */
+#define DECIMATOR_TAPS 48
+
+/* Outputs computed at once, kept in the cache while all taps are applied */
+#define DECIMATOR_BLOCK 1024
+
+template<typename T>
+spectrum::Decimator<T>::Decimator(int factor)
+    : factor(factor)
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    const int L = factor == 1 ? 1 : DECIMATOR_TAPS * factor + 1;
+    
+    this->K = (L + factor - 1) / factor;
+    this->half = (L - 1) / 2;
+    this->bank.assign(factor * this->K, 0);
+
+    /* Windowed sinc low-pass filter, the transition band ends 
+     * at the half of the decimated rate, normalized to a gain of 1 at 0 Hz */
+    std::vector<double> h(L, 1);
+    if (factor > 1) {
+        const double fc = (0.5 - 2.75 / DECIMATOR_TAPS) / factor;
+        double sum = 0;
+        
+        for (int l = 0; l < L; l++) {
+            const double t = l - (L - 1) / 2.0;
+            const double sinc = t == 0 ? 2 * fc : std::sin(2 * pi * fc * t) / (pi * t);
+            const double w = 0.42 - 0.5 * std::cos(2 * pi * l / (L - 1)) 
+                                  + 0.08 * std::cos(4 * pi * l / (L - 1));
+            h[l] = sinc * w;
+            sum += h[l];
+        }
+        for (int l = 0; l < L; l++)
+            h[l] /= sum;
+    }
+
+    for (int l = 0; l < L; l++)
+        this->bank[(l % factor) * this->K + l / factor] = (T)h[l];
+};
+
+template<typename T>
+spectrum::Decimator<T>::~Decimator() {};
+
+template<typename T>
+int
+spectrum::Decimator<T>::getFactor() {
+    return this->factor;
+};
+
+template<typename T>
+int
+spectrum::Decimator<T>::getLength() {
+    return 2 * this->half + 1;
+};
+
+template<typename T>
+int
+spectrum::Decimator<T>::getSize(int N) {
+    return (N + this->factor - 1) / this->factor;
+};
+
+template<typename T>
+void
+spectrum::Decimator<T>::process(const T* samples, const int N, T* out) {
+    const int M = this->factor;
+    const int Y = this->getSize(N);
+    
+    /* out[n] = sum of h[l] * x[n * M + l - half], l = k * M + p, 
+     * so the p-th phase reads x[(n + k) * M + p - half] = phase[n + k] */
+    const int P = Y + this->K;
+    this->phases.assign(M * P, 0);
+    
+    for (int p = 0; p < M; p++) {
+        T* phase = this->phases.data() + p * P;
+        for (int i = 0; i < P; i++) {
+            const long j = (long)i * M + p - this->half;
+            if (j >= 0 && j < N)
+                phase[i] = samples[j];
+        }
+    }
+
+    for (int b = 0; b < Y; b += DECIMATOR_BLOCK) {
+        const int n = std::min(DECIMATOR_BLOCK, Y - b);
+        T* y = out + b;
+        std::fill(y, y + n, 0);
+        
+        for (int p = 0; p < M; p++) {
+            const T* phase = this->phases.data() + p * P + b;
+            const T* h = this->bank.data() + p * this->K;
+            
+            for (int k = 0; k < this->K; k++)
+                simd::axpy(h[k], phase + k, y, n);
+        }
+    }
+};
+
+template class spectrum::Decimator<float>;
+template class spectrum::Decimator<double>;
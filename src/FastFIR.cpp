@@ -0,0 +1,122 @@
+#include "FastFIR.h"
+#include <cmath>
+#include <algorithm>
+
+template<typename T>
+spectrum::FastFIR<T>::FastFIR(const std::vector<T>& taps, int NFFT, Backend backend)
+    : L(std::max<int>(1, taps.size())),
+    NFFT(NFFT > 0 ? NFFT : getCheapestSize(std::max<int>(1, taps.size()))),
+    backend(backend),
+    kernel(this->NFFT / 2 + 1),
+    buffer(this->NFFT),
+    pending(0),
+    freq(this->NFFT / 2 + 1),
+    result(this->NFFT)
+{
+    if (!this->isValid())
+        return;
+
+    std::copy(taps.begin(), taps.end(), this->buffer.begin());
+    BasicPlan<T>::getShared(this->NFFT, this->backend)->fftr(this->buffer.data(), 
+                                                            this->kernel.data());
+    
+    for (cpx_t& k : this->kernel) {
+        k.r /= this->NFFT;
+        k.i /= this->NFFT;
+    }
+    std::fill(this->buffer.begin(), this->buffer.end(), 0);
+};
+
+template<typename T>
+spectrum::FastFIR<T>::~FastFIR() {};
+
+template<typename T>
+bool
+spectrum::FastFIR<T>::isValid() {
+    return this->NFFT % 2 == 0 && this->NFFT > this->L 
+        && BasicPlan<T>::getShared(this->NFFT, this->backend)->isValid();
+};
+
+template<typename T>
+int
+spectrum::FastFIR<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+int
+spectrum::FastFIR<T>::getLength() {
+    return this->L;
+};
+
+template<typename T>
+int
+spectrum::FastFIR<T>::getBlockSize() {
+    return this->NFFT - this->L + 1;
+};
+
+template<typename T>
+void
+spectrum::FastFIR<T>::reset() {
+    std::fill(this->buffer.begin(), this->buffer.end(), 0);
+    this->pending = 0;
+};
+
+template<typename T>
+void
+spectrum::FastFIR<T>::process(const T* samples, const int N, T* out) {
+    const int B = this->getBlockSize();
+    T* block = this->buffer.data() + this->L - 1;
+    std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(this->NFFT, this->backend);
+    
+    for (int i = 0; i < N; ) {
+        /* A block is filtered as soon as frames are given, the frames 
+         * still missing are zero: the outputs up to the last given frame 
+         * are exact, the block is filtered again when the next chunk comes */
+        const int n = std::min(B - this->pending, N - i);
+        std::copy(samples + i, samples + i + n, block + this->pending);
+        this->pending += n;
+        std::fill(block + this->pending, block + B, 0);
+        
+        plan->fftr(this->buffer.data(), this->freq.data());
+        for (int k = 0; k <= this->NFFT / 2; k++) {
+            const cpx_t x = this->freq[k], h = this->kernel[k];
+            this->freq[k].r = x.r * h.r - x.i * h.i;
+            this->freq[k].i = x.r * h.i + x.i * h.r;
+        }
+        plan->fftri(this->freq.data(), this->result.data());
+        
+        /* The first L - 1 results are wrapped around, the rest is the block */
+        const T* y = this->result.data() + this->L - 1 + this->pending - n;
+        std::copy(y, y + n, out + i);
+        i += n;
+        
+        if (this->pending == B) {
+            std::copy(this->buffer.end() - (this->L - 1), this->buffer.end(), 
+                      this->buffer.begin());
+            this->pending = 0;
+        }
+    }
+};
+
+template<typename T>
+int
+spectrum::FastFIR<T>::getCheapestSize(int L) {
+    /* Cost of a frame: NFFT * log2(NFFT) / (NFFT - L + 1) */
+    int best = 2;
+    while (best <= L)
+        best *= 2;
+    
+    double cost = best * std::log2(best) / (best - L + 1);
+    for (int n = best * 2; n <= best * 64; n *= 2) {
+        const double c = n * std::log2(n) / (n - L + 1);
+        if (c < cost) {
+            cost = c;
+            best = n;
+        }
+    }
+    return best;
+};
+
+template class spectrum::FastFIR<float>;
+template class spectrum::FastFIR<double>;
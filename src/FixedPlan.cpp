@@ -0,0 +1,88 @@
+#include "FixedPlan.h"
+#include "kissfft_i32.hh"
+#include <cstdlib>
+#include <cmath>
+
+/* 1.0 of the 32 bit FFT twiddle factors */
+#define Q30 1073741824
+
+template<>
+spectrum::FixedPlan<int16_t>::FixedPlan(int NFFT)
+    : NFFT(NFFT),
+    cfg(kiss_fftr_i16_alloc(NFFT, false, 0, 0)) {};
+
+template<>
+spectrum::FixedPlan<int32_t>::FixedPlan(int NFFT)
+    : NFFT(NFFT),
+    cfg(nullptr),
+    i32(new kissfft_i32(NFFT / 2, false, Q30, true))
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+    /* The same factors as kiss_fftr_alloc() */
+    for (int i = 0; i < NFFT / 4; i++) {
+        const double phase = -pi * ((double)(i + 1) / (NFFT / 2) + .5);
+        this->superTwiddles.push_back({(int32_t)std::lround(Q30 * std::cos(phase)),
+                                       (int32_t)std::lround(Q30 * std::sin(phase))});
+    }
+    this->work.resize(NFFT / 2);
+};
+
+template<typename T>
+spectrum::FixedPlan<T>::~FixedPlan() {
+    if (this->cfg)
+        free(this->cfg);
+};
+
+template<typename T>
+int
+spectrum::FixedPlan<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+bool
+spectrum::FixedPlan<T>::isValid() {
+    return this->cfg || this->i32;
+};
+
+template<>
+void
+spectrum::FixedPlan<int16_t>::fftr(const int16_t* timedata, kiss_fft_i16_cpx* freqdata) {
+    kiss_fftr_i16(this->cfg, timedata, freqdata);
+};
+
+template<>
+void
+spectrum::FixedPlan<int32_t>::fftr(const int32_t* timedata, kiss_fft_i32_cpx* freqdata) {
+    /* Even samples in the real parts, odd samples in the imaginary parts */
+    const std::complex<int32_t>* x = (const std::complex<int32_t>*)timedata;
+    std::complex<int32_t>* y = this->work.data();
+    this->i32->transform(x, y);
+
+    /* Splitting the spectra of the even and odd samples, as kiss_fftr() 
+     * with FIXED_POINT: the halves keep the sums in 32 bit */
+    const int ncfft = this->NFFT / 2;
+    const int32_t dr = y[0].real() / 2, di = y[0].imag() / 2;
+    freqdata[0].r = dr + di;
+    freqdata[ncfft].r = dr - di;
+    freqdata[ncfft].i = freqdata[0].i = 0;
+
+    for (int k = 1; k <= ncfft / 2; k++) {
+        const int64_t pr = y[k].real() / 2, pi = y[k].imag() / 2;
+        const int64_t nr = y[ncfft - k].real() / 2, ni = -y[ncfft - k].imag() / 2;
+        const int64_t f1r = pr + nr, f1i = pi + ni;
+        const int64_t f2r = pr - nr, f2i = pi - ni;
+        const std::complex<int32_t> w = this->superTwiddles[k - 1];
+        const int64_t tr = (f2r * w.real() - f2i * w.imag()) / Q30;
+        const int64_t ti = (f2r * w.imag() + f2i * w.real()) / Q30;
+
+        freqdata[k].r = (int32_t)((f1r + tr) / 2);
+        freqdata[k].i = (int32_t)((f1i + ti) / 2);
+        freqdata[ncfft - k].r = (int32_t)((f1r - tr) / 2);
+        freqdata[ncfft - k].i = (int32_t)((ti - f1i) / 2);
+    }
+};
+
+template class spectrum::FixedPlan<int16_t>;
+template class spectrum::FixedPlan<int32_t>;
@@ -0,0 +1,207 @@
+#include "FixedProcessing.h"
+#include <algorithm>
+#include <limits>
+
+template<typename T>
+spectrum::FixedProcessing<T>::FixedProcessing(int NFFT, const char* AUDIOFILE) 
+    : NFFT(NFFT), 
+    FILE(AUDIOFILE)
+{
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        spectrum::terminate(BAD_NFFT);
+
+    /* file.samples - contains a vector of vectors,
+     * which contains the T frames of each channel */
+    if (!this->file.load(this->FILE))
+        spectrum::terminate(BAD_PCM);
+};
+
+template<typename T>
+spectrum::FixedProcessing<T>::~FixedProcessing() {};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+float 
+spectrum::FixedProcessing<T>::getFreqPerBin() {
+    return ((float)this->getSampleRate() / (float)this->NFFT);
+};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getSampleRate() {
+    return this->file.getSampleRate();
+};
+
+template<typename T>
+float 
+spectrum::FixedProcessing<T>::getFileDuration() {
+    return this->file.getLengthInSeconds();
+};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getFramesPerChannel() {
+    return this->file.getNumSamplesPerChannel();
+};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getTotalFrames() {
+    return this->getFramesPerChannel() * this->getChannels();
+};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getChannels() {
+    return this->file.getNumChannels();
+};
+
+template<typename T>
+std::vector<std::vector<T>> 
+spectrum::FixedProcessing<T>::getFrames() {
+    return this->file.samples;
+};
+
+template<typename T>
+int 
+spectrum::FixedProcessing<T>::getBitDepth() {
+    return this->file.getBitDepth();
+};
+
+template<typename T>
+bool 
+spectrum::FixedProcessing<T>::isMono() {
+    return this->file.isMono();
+};
+
+template<typename T>
+void 
+spectrum::FixedProcessing<T>::printSummary() {
+    std::cout << "FFT Window size: " << this->getNFFT()
+              << "\nFrequency per bin: " << this->getFreqPerBin()
+              << "\nSample rate: " << this->getSampleRate()
+              << "\nDuration in seconds: " << this->getFileDuration()
+              << "\nFrames per channel: " << this->getFramesPerChannel()
+              << "\nTotal frames: " << this->getTotalFrames()
+              << "\nNumber of channels: " << this->getChannels()
+              << "\nBit depth: " << this->getBitDepth()
+              << std::endl;
+};
+
+template<typename T>
+typename spectrum::FixedProcessing<T>::storage_t 
+spectrum::FixedProcessing<T>::getfftValues() {
+    return this->_peekValues(this->storage);
+};
+
+template<typename T>
+typename spectrum::FixedProcessing<T>::storage_t 
+spectrum::FixedProcessing<T>::getpfftValues() {
+    return this->_peekValues(this->pstorage);
+};
+
+template<typename T>
+typename spectrum::FixedProcessing<T>::storage_t 
+spectrum::FixedProcessing<T>::getpfftValues(int channel) {
+    if (channel >= this->getChannels() || channel < 0)
+        spectrum::terminate(BAD_CHANNEL);
+    
+    return this->_peekValues(this->pstorage, channel);
+};
+
+template<typename T>
+void 
+spectrum::FixedProcessing<T>::FFT() {
+    FixedPlan<T> plan(this->NFFT);
+     
+    if (!plan.isValid())
+        spectrum::terminate(BAD_ALLOCATE);
+    
+    std::vector<T> window(this->NFFT);
+    for (int i = 0; i < this->getChannels(); i++)
+        this->_transform(plan, this->storage, i, 0, -1, window);
+};
+
+template<typename T>
+void 
+spectrum::FixedProcessing<T>::pFFT(int timeScale) {
+    FixedPlan<T> plan(this->NFFT);
+
+    if (!plan.isValid())
+        spectrum::terminate(BAD_ALLOCATE);
+
+    if (timeScale < 1 || timeScale > 1000 )
+        spectrum::terminate(BAD_TIMESCALE);
+    
+    const int segment = this->getSampleRate() / timeScale;
+    
+    std::vector<T> window(this->NFFT);
+    for (int i = 0; i < this->getChannels(); i++) {
+        for (int j = 0; (float)j < this->getFileDuration() * timeScale; j++)
+            this->_transform(plan, this->pstorage, i, segment * j, 
+                             (float)j / timeScale, window);
+    }
+};
+
+template<typename T>
+void 
+spectrum::FixedProcessing<T>::_transform(FixedPlan<T>& plan, lstorage_t& s, int channel, 
+                                         int frame, float time, std::vector<T>& window) {
+    s.push_back(
+            Keepeth<std::unique_ptr<cpx_t[]>, std::unique_ptr<power_t[]>>
+                    (channel, this->getFreqPerBin(), time, 
+                    std::unique_ptr<cpx_t[]>(new cpx_t[this->NFFT / 2 + 1]),
+                    std::unique_ptr<power_t[]>(new power_t[this->NFFT / 2 + 1]), 
+                    0, frame, this->NFFT / 2 + 1)
+    );
+    
+    /* The window of NFFT frames, zero padded past the end of the channel */
+    const std::vector<T>& samples = this->file.samples[channel];
+    const int n = std::max(0, std::min(this->NFFT, (int)samples.size() - frame));
+    
+    if (n > 0)
+        std::copy(samples.begin() + frame, samples.begin() + frame + n, window.begin());
+    std::fill(window.begin() + n, window.end(), 0);
+    
+    plan.fftr(window.data(), s.back().values.get());
+    this->power(s.back().values.get(), s.back().scaledValues.get());
+};
+
+template<typename T>
+void 
+spectrum::FixedProcessing<T>::power(const cpx_t* fft, power_t* power) {
+    /* r^2 + i^2 of two T values only overflows power_t 
+     * for r = i = the minimum of T, so the sum is taken unsigned */
+    for (int i = 0; i < this->NFFT / 2 + 1; i++) {
+        const uint64_t p = (uint64_t)((int64_t)fft[i].r * fft[i].r) 
+                         + (uint64_t)((int64_t)fft[i].i * fft[i].i);
+        power[i] = (power_t)std::min<uint64_t>(p, std::numeric_limits<power_t>::max());
+    }
+};
+
+template<typename T>
+typename spectrum::FixedProcessing<T>::storage_t 
+spectrum::FixedProcessing<T>::_peekValues(lstorage_t& s, const int channel) {
+    if (s.empty()) 
+        spectrum::terminate(EMPTY_CONTAINER);
+
+    return spectrum::peekValues<storage_t>(s, 0, s.size(), channel);
+};
+
+template class spectrum::FixedProcessing<int16_t>;
+template class spectrum::FixedProcessing<int32_t>;
+
+std::ostream& 
+operator<<(std::ostream& os, kiss_fft_i16_cpx const& k) {
+    return os << k.r << ';' << k.i;
+};
+
+std::ostream& 
+operator<<(std::ostream& os, kiss_fft_i32_cpx const& k) {
+    return os << k.r << ';' << k.i;
+};
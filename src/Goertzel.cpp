@@ -0,0 +1,56 @@
+#include "Goertzel.h"
+#include <cmath>
+#include <algorithm>
+
+template<typename T>
+spectrum::Goertzel<T>::Goertzel(const std::vector<float>& frequencies, int sampleRate) 
+    : s1(frequencies.size()),
+    s2(frequencies.size())
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+    for (float f : frequencies)
+        this->coefficients.push_back((T)(2 * std::cos(2 * pi * f / sampleRate)));
+};
+
+template<typename T>
+spectrum::Goertzel<T>::~Goertzel() {};
+
+template<typename T>
+int
+spectrum::Goertzel<T>::getSize() {
+    return this->coefficients.size();
+};
+
+template<typename T>
+void
+spectrum::Goertzel<T>::magnitudes(const T* samples, const int N, T* magnitudes) {
+    const int K = this->coefficients.size();
+    const T* c = this->coefficients.data();
+    T* s1 = this->s1.data();
+    T* s2 = this->s2.data();
+
+    std::fill(s1, s1 + K, 0);
+    std::fill(s2, s2 + K, 0);
+
+    /* s[n] = x[n] + 2 * cos(w) * s[n - 1] - s[n - 2], 
+     * the inner loop over the frequencies has no dependencies 
+     * and is vectorized by the compiler */
+    for (int n = 0; n < N; n++) {
+        const T x = samples[n];
+        for (int k = 0; k < K; k++) {
+            const T s0 = x + c[k] * s1[k] - s2[k];
+            s2[k] = s1[k];
+            s1[k] = s0;
+        }
+    }
+
+    /* |y|^2 = s[N - 1]^2 + s[N - 2]^2 - 2 * cos(w) * s[N - 1] * s[N - 2] */
+    for (int k = 0; k < K; k++) {
+        const T p = s1[k] * s1[k] + s2[k] * s2[k] - c[k] * s1[k] * s2[k];
+        magnitudes[k] = std::sqrt(std::max<T>(p, 0));
+    }
+};
+
+template class spectrum::Goertzel<float>;
+template class spectrum::Goertzel<double>;
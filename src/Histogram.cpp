@@ -0,0 +1,101 @@
+#include "Histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* Every power of 2 above 2^HISTOGRAM_BITS is split 
+ * into 2^(HISTOGRAM_BITS - 1) buckets */
+#define HISTOGRAM_BITS 6
+
+spectrum::Histogram::Histogram()
+    : buckets(_bucket(std::numeric_limits<long long>::max()) + 1),
+    count(0),
+    max(0)
+{
+    this->reset();
+};
+
+spectrum::Histogram::~Histogram() {};
+
+int
+spectrum::Histogram::_bucket(long long value) {
+    /* Values below 2^HISTOGRAM_BITS have a bucket each, 
+     * the others are shifted right by e bits, keeping 
+     * their HISTOGRAM_BITS highest bits: 2^(HISTOGRAM_BITS - 1) buckets 
+     * of a width of 2^e for every e */
+    int bits = 0;
+    while (bits < 63 && (value >> bits) != 0)
+        bits++;
+    
+    const int e = bits - HISTOGRAM_BITS;
+    if (e <= 0)
+        return (int)value;
+    
+    const int half = 1 << (HISTOGRAM_BITS - 1);
+    return 2 * half + (e - 1) * half + (int)(value >> e) - half;
+};
+
+long long
+spectrum::Histogram::_upper(int bucket) {
+    const int half = 1 << (HISTOGRAM_BITS - 1);
+    if (bucket < 2 * half)
+        return bucket;
+    
+    const int e = (bucket - 2 * half) / half + 1;
+    const long long sub = (bucket - 2 * half) % half + half;
+    
+    /* The last bucket ends at the largest value */
+    if (sub + 1 >= (std::numeric_limits<long long>::max() >> e))
+        return std::numeric_limits<long long>::max();
+    return ((sub + 1) << e) - 1;
+};
+
+void
+spectrum::Histogram::record(long long value) {
+    value = std::max(0LL, value);
+    
+    this->buckets[_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+    
+    long long max = this->max.load(std::memory_order_relaxed);
+    while (value > max && 
+           !this->max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+};
+
+long long
+spectrum::Histogram::getCount() {
+    return this->count.load(std::memory_order_relaxed);
+};
+
+long long
+spectrum::Histogram::getMax() {
+    return this->max.load(std::memory_order_relaxed);
+};
+
+long long
+spectrum::Histogram::getPercentile(double percentile) {
+    const long long count = this->getCount();
+    if (count == 0)
+        return 0;
+    
+    /* The rank of the value, from 1 to count */
+    percentile = std::min(100.0, std::max(0.0, percentile));
+    const long long rank = std::max(1LL, (long long)std::ceil(percentile / 100 * count));
+    
+    long long n = 0;
+    for (int i = 0; i < (int)this->buckets.size(); i++) {
+        n += this->buckets[i].load(std::memory_order_relaxed);
+        if (n >= rank)
+            return std::min(_upper(i), this->getMax());
+    }
+    return this->getMax();
+};
+
+void
+spectrum::Histogram::reset() {
+    for (std::atomic<long long>& bucket : this->buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    
+    this->count.store(0, std::memory_order_relaxed);
+    this->max.store(0, std::memory_order_relaxed);
+};
@@ -0,0 +1,102 @@
+#include "Mel.h"
+#include <cmath>
+#include <algorithm>
+
+/* The energies are limited to this value before the log */
+#define MEL_FLOOR 1e-10
+
+static double
+_mel(double f) {
+    return 2595 * std::log10(1 + f / 700);
+};
+
+static double
+_hz(double mel) {
+    return 700 * (std::pow(10, mel / 2595) - 1);
+};
+
+template<typename T>
+spectrum::Mel<T>::Mel(int NFFT, int sampleRate, int filters, int coefficients, 
+                      float fmin, float fmax) 
+    : logEnergies(filters)
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    const double bin = (double)sampleRate / NFFT;
+
+    /* filters + 2 edges equally spaced on the mel scale, 
+     * the m-th filter rises from edge m to m + 1 and falls to m + 2 */
+    std::vector<double> edges;
+    for (int m = 0; m < filters + 2; m++)
+        edges.push_back(_hz(_mel(fmin) + (_mel(fmax) - _mel(fmin)) * m / (filters + 1)));
+
+    this->offset.push_back(0);
+    for (int m = 0; m < filters; m++) {
+        const int first = std::max(0, (int)std::ceil(edges[m] / bin));
+        const int last = std::min(NFFT / 2, (int)std::floor(edges[m + 2] / bin));
+        
+        this->start.push_back(first);
+        for (int j = first; j <= last; j++) {
+            const double f = j * bin;
+            const double w = f <= edges[m + 1] 
+                    ? (f - edges[m]) / (edges[m + 1] - edges[m])
+                    : (edges[m + 2] - f) / (edges[m + 2] - edges[m + 1]);
+            this->weights.push_back((T)std::max(0.0, w));
+        }
+        this->offset.push_back(this->weights.size());
+    }
+
+    for (int c = 0; c < coefficients; c++) {
+        const double scale = std::sqrt((c == 0 ? 1.0 : 2.0) / filters);
+        for (int m = 0; m < filters; m++)
+            this->dct.push_back((T)(scale * std::cos(pi * c * (m + 0.5) / filters)));
+    }
+};
+
+template<typename T>
+spectrum::Mel<T>::~Mel() {};
+
+template<typename T>
+int
+spectrum::Mel<T>::getFilters() {
+    return this->start.size();
+};
+
+template<typename T>
+int
+spectrum::Mel<T>::getCoefficients() {
+    return this->start.empty() ? 0 : this->dct.size() / this->start.size();
+};
+
+template<typename T>
+void
+spectrum::Mel<T>::energies(const cpx_t* spectrum, T* values) {
+    for (int m = 0; m < (int)this->start.size(); m++) {
+        const cpx_t* x = spectrum + this->start[m];
+        const T* w = this->weights.data() + this->offset[m];
+        const int n = this->offset[m + 1] - this->offset[m];
+        T e = 0;
+        
+        for (int j = 0; j < n; j++)
+            e += w[j] * (x[j].r * x[j].r + x[j].i * x[j].i);
+        values[m] = std::log(std::max<T>(e, (T)MEL_FLOOR));
+    }
+};
+
+template<typename T>
+void
+spectrum::Mel<T>::mfcc(const cpx_t* spectrum, T* coefficients) {
+    const int M = this->getFilters();
+    this->energies(spectrum, this->logEnergies.data());
+    
+    for (int c = 0; c < this->getCoefficients(); c++) {
+        const T* d = this->dct.data() + c * M;
+        T s = 0;
+        
+        for (int m = 0; m < M; m++)
+            s += d[m] * this->logEnergies[m];
+        coefficients[c] = s;
+    }
+};
+
+template class spectrum::Mel<float>;
+template class spectrum::Mel<double>;
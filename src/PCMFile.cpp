@@ -0,0 +1,168 @@
+#include "PCMFile.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+/* WAVE_FORMAT_PCM and WAVE_FORMAT_EXTENSIBLE format tags of the fmt chunk */
+#define WAV_PCM 0x0001
+#define WAV_EXTENSIBLE 0xFFFE
+
+/* Frames decoded per read of the data chunk */
+#define PCM_BLOCK 4096
+
+static uint32_t
+_le(const unsigned char* b, int bytes) {
+    uint32_t v = 0;
+    for (int i = 0; i < bytes; i++)
+        v |= (uint32_t)b[i] << (8 * i);
+    return v;
+};
+
+int32_t
+spectrum::decodePCMSample(const unsigned char* sample, int bytes) {
+    if (bytes == 1)
+        return (int32_t)((uint32_t)(sample[0] ^ 0x80) << 24);
+    return (int32_t)(_le(sample, bytes) << (32 - 8 * bytes));
+};
+
+bool
+spectrum::readPCMFormat(std::istream& in, PCMFormat& f) {
+    unsigned char header[12];
+    
+    if (!in.read((char*)header, 12) 
+        || std::memcmp(header, "RIFF", 4) != 0 
+        || std::memcmp(header + 8, "WAVE", 4) != 0)
+        return false;
+    
+    int format = 0;
+    f.channels = f.sampleRate = f.bitDepth = f.blockAlign = 0;
+    
+    /* Chunks up to the data chunk: only "fmt " is needed,
+     * the others are skipped (chunks are padded to an even size) */
+    unsigned char chunk[8];
+    while (in.read((char*)chunk, 8)) {
+        const uint32_t size = _le(chunk + 4, 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            unsigned char fmt[40] = {0};
+            if (size < 16 || !in.read((char*)fmt, std::min<uint32_t>(size, 40)))
+                return false;
+            in.seekg(size - std::min<uint32_t>(size, 40) + size % 2, std::ios::cur);
+            
+            format = _le(fmt, 2);
+            f.channels = _le(fmt + 2, 2);
+            f.sampleRate = _le(fmt + 4, 4);
+            f.blockAlign = _le(fmt + 12, 2);
+            f.bitDepth = _le(fmt + 14, 2);
+            
+            /* The actual format is the first field of the sub format GUID */
+            if (format == WAV_EXTENSIBLE && size >= 40)
+                format = _le(fmt + 24, 2);
+            continue;
+        }
+
+        if (std::memcmp(chunk, "data", 4) != 0) {
+            in.seekg(size + size % 2, std::ios::cur);
+            continue;
+        }
+        
+        const int bytes = f.bitDepth / 8;
+        if (format != WAV_PCM || f.channels <= 0 || f.bitDepth % 8 != 0 
+            || bytes < 1 || bytes > 4 || f.blockAlign < f.channels * bytes)
+            return false;
+
+        /* A data chunk size larger than the file 
+         * (as written by streaming encoders) is read to the end of file */
+        const std::streampos begin = in.tellg();
+        in.seekg(0, std::ios::end);
+        f.frames = std::min<size_t>(size, in.tellg() - begin) / f.blockAlign;
+        in.seekg(begin);
+        return true;
+    }
+    return false;
+};
+
+template<typename T>
+spectrum::PCMFile<T>::PCMFile() 
+    : sampleRate(0),
+    bitDepth(0) {};
+
+template<typename T>
+spectrum::PCMFile<T>::~PCMFile() {};
+
+template<typename T>
+bool
+spectrum::PCMFile<T>::load(const char* FILE) {
+    std::ifstream in(FILE, std::ios::binary);
+    PCMFormat f;
+
+    this->samples.clear();
+    
+    if (!readPCMFormat(in, f))
+        return false;
+    
+    this->sampleRate = f.sampleRate;
+    this->bitDepth = f.bitDepth;
+    const int bytes = f.bitDepth / 8;
+
+    /* The frames are interleaved: decoding a block at a time into the channels */
+    std::vector<unsigned char> block((size_t)PCM_BLOCK * f.blockAlign);
+    
+    this->samples.resize(f.channels);
+    for (int i = 0; i < f.channels; i++)
+        this->samples[i].reserve(f.frames);
+
+    for (size_t n0 = 0; n0 < f.frames; ) {
+        const size_t n = std::min<size_t>(PCM_BLOCK, f.frames - n0);
+        if (!in.read((char*)block.data(), n * f.blockAlign))
+            return false;
+        
+        for (size_t j = 0; j < n; j++) {
+            const unsigned char* frame = block.data() + j * f.blockAlign;
+            for (int i = 0; i < f.channels; i++) 
+                this->samples[i].push_back(
+                    (T)(decodePCMSample(frame + i * bytes, bytes) >> (32 - 8 * sizeof(T))));
+        }
+        n0 += n;
+    }
+    return true;
+};
+
+template<typename T>
+int
+spectrum::PCMFile<T>::getSampleRate() {
+    return this->sampleRate;
+};
+
+template<typename T>
+int
+spectrum::PCMFile<T>::getBitDepth() {
+    return this->bitDepth;
+};
+
+template<typename T>
+int
+spectrum::PCMFile<T>::getNumChannels() {
+    return this->samples.size();
+};
+
+template<typename T>
+int
+spectrum::PCMFile<T>::getNumSamplesPerChannel() {
+    return this->samples.empty() ? 0 : this->samples[0].size();
+};
+
+template<typename T>
+float
+spectrum::PCMFile<T>::getLengthInSeconds() {
+    return this->sampleRate ? (float)this->getNumSamplesPerChannel() / (float)this->sampleRate : 0;
+};
+
+template<typename T>
+bool
+spectrum::PCMFile<T>::isMono() {
+    return this->getNumChannels() == 1;
+};
+
+template class spectrum::PCMFile<int16_t>;
+template class spectrum::PCMFile<int32_t>;
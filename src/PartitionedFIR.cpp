@@ -0,0 +1,101 @@
+#include "PartitionedFIR.h"
+#include <algorithm>
+
+template<typename T>
+spectrum::PartitionedFIR<T>::PartitionedFIR(const std::vector<T>& taps, int blockSize, 
+                                            Backend backend)
+    : B(blockSize),
+    P(std::max<int>(1, (taps.size() + blockSize - 1) / blockSize)),
+    backend(backend),
+    partitions(P * (blockSize + 1)),
+    delay(P * (blockSize + 1)),
+    pos(0),
+    input(2 * blockSize),
+    accumulator(blockSize + 1),
+    result(2 * blockSize)
+{
+    if (!this->isValid())
+        return;
+
+    std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(2 * this->B, this->backend);
+
+    /* The p-th partition is zero padded to 2 * B taps */
+    for (int p = 0; p < this->P; p++) {
+        const int beg = std::min<int>(p * this->B, taps.size());
+        const int end = std::min<int>(beg + this->B, taps.size());
+        cpx_t* H = this->partitions.data() + p * (this->B + 1);
+        
+        std::fill(this->input.begin(), this->input.end(), 0);
+        std::copy(taps.begin() + beg, taps.begin() + end, this->input.begin());
+        plan->fftr(this->input.data(), H);
+        
+        for (int k = 0; k <= this->B; k++) {
+            H[k].r /= 2 * this->B;
+            H[k].i /= 2 * this->B;
+        }
+    }
+    this->reset();
+};
+
+template<typename T>
+spectrum::PartitionedFIR<T>::~PartitionedFIR() {};
+
+template<typename T>
+bool
+spectrum::PartitionedFIR<T>::isValid() {
+    return this->B > 0 && BasicPlan<T>::getShared(2 * this->B, this->backend)->isValid();
+};
+
+template<typename T>
+int
+spectrum::PartitionedFIR<T>::getBlockSize() {
+    return this->B;
+};
+
+template<typename T>
+int
+spectrum::PartitionedFIR<T>::getPartitions() {
+    return this->P;
+};
+
+template<typename T>
+void
+spectrum::PartitionedFIR<T>::reset() {
+    std::fill(this->input.begin(), this->input.end(), 0);
+    std::fill(this->delay.begin(), this->delay.end(), cpx_t{0, 0});
+    this->pos = 0;
+};
+
+template<typename T>
+void
+spectrum::PartitionedFIR<T>::process(const T* block, T* out) {
+    const int S = this->B + 1;
+    std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(2 * this->B, this->backend);
+    
+    /* The newest spectrum replaces the oldest one */
+    std::copy(this->input.begin() + this->B, this->input.end(), this->input.begin());
+    std::copy(block, block + this->B, this->input.begin() + this->B);
+    this->pos = (this->pos + this->P - 1) % this->P;
+    plan->fftr(this->input.data(), this->delay.data() + this->pos * S);
+    
+    /* The p-th last spectrum is the (pos + p) % P-th one */
+    std::fill(this->accumulator.begin(), this->accumulator.end(), cpx_t{0, 0});
+    cpx_t* Y = this->accumulator.data();
+    
+    for (int p = 0; p < this->P; p++) {
+        const cpx_t* X = this->delay.data() + (this->pos + p) % this->P * S;
+        const cpx_t* H = this->partitions.data() + p * S;
+        
+        for (int k = 0; k < S; k++) {
+            Y[k].r += X[k].r * H[k].r - X[k].i * H[k].i;
+            Y[k].i += X[k].r * H[k].i + X[k].i * H[k].r;
+        }
+    }
+    plan->fftri(Y, this->result.data());
+    
+    /* The first B results are wrapped around */
+    std::copy(this->result.begin() + this->B, this->result.end(), out);
+};
+
+template class spectrum::PartitionedFIR<float>;
+template class spectrum::PartitionedFIR<double>;
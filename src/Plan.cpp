@@ -0,0 +1,125 @@
+#include "Plan.h"
+#include <list>
+#include <utility>
+
+/* The number of plans kept by a thread, the least recently used one 
+ * is dropped (the objects using it keep it) */
+#define PLAN_CACHE 8
+
+template<>
+spectrum::BasicPlan<float>::BasicPlan(int NFFT, Backend backend)
+    : NFFT(NFFT),
+    backend(backend),
+    cfg(nullptr),
+    cfg64(nullptr),
+    icfg(nullptr),
+    icfg64(nullptr)
+{
+    if (this->backend == STOCKHAM && !Stockham::isSupported(this->NFFT))
+        this->backend = KISSFFT;
+
+    if (this->backend == STOCKHAM)
+        this->stockham.reset(new Stockham(this->NFFT));
+    else
+        this->cfg = kiss_fftr_alloc(this->NFFT, false, 0, 0);
+};
+
+template<>
+spectrum::BasicPlan<double>::BasicPlan(int NFFT, Backend)
+    : NFFT(NFFT),
+    backend(KISSFFT),
+    cfg(nullptr),
+    cfg64(kiss_fftr_f64_alloc(NFFT, false, 0, 0)),
+    icfg(nullptr),
+    icfg64(nullptr) {};
+
+template<typename T>
+spectrum::BasicPlan<T>::~BasicPlan() {
+    if (this->cfg)
+        kiss_fft_free(this->cfg);
+    if (this->cfg64)
+        kiss_fft_free(this->cfg64);
+    if (this->icfg)
+        kiss_fft_free(this->icfg);
+    if (this->icfg64)
+        kiss_fft_free(this->icfg64);
+};
+
+template<typename T>
+int
+spectrum::BasicPlan<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+spectrum::Backend
+spectrum::BasicPlan<T>::getBackend() {
+    return this->backend;
+};
+
+template<typename T>
+bool
+spectrum::BasicPlan<T>::isValid() {
+    return this->cfg || this->cfg64 || this->stockham;
+};
+
+template<typename T>
+std::shared_ptr<spectrum::BasicPlan<T>>
+spectrum::BasicPlan<T>::getShared(int NFFT, Backend backend) {
+    typedef std::pair<int, Backend> key_t;
+    thread_local std::list<std::pair<key_t, std::shared_ptr<BasicPlan>>> plans;
+    
+    /* The most recently used plans are the first ones */
+    const key_t key = std::make_pair(NFFT, backend);
+    for (auto i = plans.begin(); i != plans.end(); i++) {
+        if (i->first == key) {
+            plans.splice(plans.begin(), plans, i);
+            return plans.front().second;
+        }
+    }
+    
+    /* A plan that cannot be allocated is not kept, 
+     * the next request tries again */
+    std::shared_ptr<BasicPlan> plan(new BasicPlan(NFFT, backend));
+    if (!plan->isValid())
+        return plan;
+    
+    plans.emplace_front(key, plan);
+    if (plans.size() > PLAN_CACHE)
+        plans.pop_back();
+    return plan;
+};
+
+template<>
+void
+spectrum::BasicPlan<float>::fftr(const float* timedata, kiss_fft_cpx* freqdata) {
+    if (this->backend == STOCKHAM)
+        this->stockham->fftr(timedata, freqdata);
+    else
+        kiss_fftr(this->cfg, timedata, freqdata);
+};
+
+template<>
+void
+spectrum::BasicPlan<double>::fftr(const double* timedata, kiss_fft_f64_cpx* freqdata) {
+    kiss_fftr_f64(this->cfg64, timedata, freqdata);
+};
+
+template<>
+void
+spectrum::BasicPlan<float>::fftri(const kiss_fft_cpx* freqdata, float* timedata) {
+    if (!this->icfg)
+        this->icfg = kiss_fftr_alloc(this->NFFT, true, 0, 0);
+    kiss_fftri(this->icfg, freqdata, timedata);
+};
+
+template<>
+void
+spectrum::BasicPlan<double>::fftri(const kiss_fft_f64_cpx* freqdata, double* timedata) {
+    if (!this->icfg64)
+        this->icfg64 = kiss_fftr_f64_alloc(this->NFFT, true, 0, 0);
+    kiss_fftri_f64(this->icfg64, freqdata, timedata);
+};
+
+template class spectrum::BasicPlan<float>;
+template class spectrum::BasicPlan<double>;
@@ -1,8 +1,12 @@
 #include "Processing.h"
 
-spectrum::Processing::Processing(int NFFT, const char* AUDIOFILE) 
+template<typename T>
+spectrum::BasicProcessing<T>::BasicProcessing(int NFFT, const char* AUDIOFILE, Backend backend, 
+                                             bool readAhead) 
     : NFFT(NFFT), 
-    FILE(AUDIOFILE) 
+    FILE(AUDIOFILE),
+    backend(backend),
+    file(new AudioFile<T>())
 {
     if (NFFT <= 0 || NFFT % 2 != 0)
         this->_terminate(BAD_NFFT);
@@ -11,78 +15,123 @@ spectrum::Processing::Processing(int NFFT, const char* AUDIOFILE)
      * Reading data from an audio file
      * file.samples - contains a vector of vectors,
      * which contains the frames of each channel */
-    this->file.load(this->FILE);
+    if (readAhead) {
+        this->reader.reset(new ReadAhead<T>());
+        if (!this->reader->start(this->FILE, this->file))
+            this->reader.reset();
+    }
+    if (!this->reader)
+        this->file->load(this->FILE);
+    
+    /* Use this value in the future to normalize the FFT values */
+    this->dynamicRange = spectrum::dynamicRange<T>(this->getBitDepth());
+};
+
+template<typename T>
+spectrum::BasicProcessing<T>::BasicProcessing(int NFFT, std::vector<uint8_t>& data, 
+                                             const char* AUDIOFILE, Backend backend) 
+    : NFFT(NFFT), 
+    FILE(AUDIOFILE),
+    backend(backend),
+    file(new AudioFile<T>())
+{
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        this->_terminate(BAD_NFFT);
+
+    /* The format is told by the first 4 bytes */
+    if (data.size() >= 4)
+        this->file->loadFromMemory(data);
     
-    /* Dynamic range
-     * With a bit depth of 16 bits from 32767 to -32768 (65536)
-     * Is equal to 96.33Db
-     * Use this value in the future to normalize the FFT values */
-    this->dynamicRange = std::abs(20.0f * log10f(1.0f / (float)std::pow(2, this->getBitDepth())));
+    this->dynamicRange = spectrum::dynamicRange<T>(this->getBitDepth());
 };
 
-template<typename v, typename sV>
-spectrum::Processing::Keepeth<v, sV>::Keepeth(int ch, float fpb, float t, v vls, sV sVls)
-    : channel(ch),
-    freqPerBin(fpb),
-    time(t),
-    /* Transfer of ownership of the pointer in the initializer (std::move) */
-    values(std::move(vls)),
-    scaledValues(std::move(sVls)) {};
+template<typename T>
+spectrum::BasicProcessing<T>::BasicProcessing(int NFFT, const BasicProcessing& source, 
+                                             Backend backend) 
+    : NFFT(NFFT), 
+    FILE(source.FILE),
+    backend(backend),
+    file(source.file),
+    reader(source.reader),
+    dynamicRange(source.dynamicRange)
+{
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        this->_terminate(BAD_NFFT);
+};
 
-spectrum::Processing::~Processing() {};
+template<typename T>
+spectrum::BasicProcessing<T>::~BasicProcessing() {};
 
+template<typename T>
 int 
-spectrum::Processing::getNFFT() {
+spectrum::BasicProcessing<T>::getNFFT() {
     return this->NFFT;
 };
 
+template<typename T>
+spectrum::Backend 
+spectrum::BasicProcessing<T>::getBackend() {
+    return this->backend;
+};
+
+template<typename T>
 float 
-spectrum::Processing::getFreqPerBin() {
+spectrum::BasicProcessing<T>::getFreqPerBin() {
     return ((float)this->getSampleRate() / (float)this->NFFT);
 };
 
+template<typename T>
 int 
-spectrum::Processing::getSampleRate() {
-    return this->file.getSampleRate();
+spectrum::BasicProcessing<T>::getSampleRate() {
+    return this->file->getSampleRate();
 };
 
+template<typename T>
 float 
-spectrum::Processing::getFileDuration() {
-    return this->file.getLengthInSeconds();
+spectrum::BasicProcessing<T>::getFileDuration() {
+    return this->file->getLengthInSeconds();
 };
 
+template<typename T>
 int 
-spectrum::Processing::getFramesPerChannel() {
-    return this->file.getNumSamplesPerChannel();
+spectrum::BasicProcessing<T>::getFramesPerChannel() {
+    return this->file->getNumSamplesPerChannel();
 };
 
+template<typename T>
 int 
-spectrum::Processing::getTotalFrames() {
+spectrum::BasicProcessing<T>::getTotalFrames() {
     return this->getFramesPerChannel() * this->getChannels();
 };
 
+template<typename T>
 int 
-spectrum::Processing::getChannels() {
-    return this->file.getNumChannels();
+spectrum::BasicProcessing<T>::getChannels() {
+    return this->file->getNumChannels();
 };
 
-std::vector<std::vector<float>> 
-spectrum::Processing::getFrames() {
-    return this->file.samples;
+template<typename T>
+std::vector<std::vector<T>> 
+spectrum::BasicProcessing<T>::getFrames() {
+    this->_wait();
+    return this->file->samples;
 };
 
+template<typename T>
 int 
-spectrum::Processing::getBitDepth() {
-    return this->file.getBitDepth();
+spectrum::BasicProcessing<T>::getBitDepth() {
+    return this->file->getBitDepth();
 };
 
+template<typename T>
 bool 
-spectrum::Processing::isMono() {
-    return this->file.isMono();
+spectrum::BasicProcessing<T>::isMono() {
+    return this->file->isMono();
 };
 
+template<typename T>
 void 
-spectrum::Processing::printSummary() {
+spectrum::BasicProcessing<T>::printSummary() {
     std::cout << "FFT Window size: " << this->getNFFT()
               << "\nFrequency per bin: " << this->getFreqPerBin()
               << "\nSample rate: " << this->getSampleRate()
@@ -94,178 +143,787 @@ spectrum::Processing::printSummary() {
               << std::endl;
 };
 
-spectrum::Processing::storage_t 
-spectrum::Processing::getfftValues() {
-    return this->_peekValues(this->storage, 0, this->storage.size());
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::decimate(int factor) {
+    if (factor < 1 || this->getSampleRate() % factor != 0)
+        this->_terminate(BAD_FACTOR);
+
+    this->_detach();
+    
+    Decimator<T> decimator(factor);
+    
+    for (int i = 0; i < this->getChannels(); i++) {
+        std::vector<T>& samples = this->file->samples[i];
+        std::vector<T> decimated(decimator.getSize(samples.size()));
+        
+        decimator.process(samples.data(), samples.size(), decimated.data());
+        samples.swap(decimated);
+    }
+    this->file->setSampleRate(this->getSampleRate() / factor);
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::resample(int sampleRate) {
+    if (sampleRate < 1)
+        this->_terminate(BAD_RATE);
+
+    if (sampleRate == this->getSampleRate())
+        return;
+
+    this->_detach();
+    
+    Resampler<T> resampler(this->getSampleRate(), sampleRate);
+    
+    for (int i = 0; i < this->getChannels(); i++) {
+        std::vector<T>& samples = this->file->samples[i];
+        std::vector<T> resampled(resampler.getSize(samples.size()));
+        
+        const int n = resampler.process(samples.data(), samples.size(), resampled.data());
+        resampler.flush(resampled.data() + n);
+        samples.swap(resampled);
+    }
+    this->file->setSampleRate(sampleRate);
 };
 
-spectrum::Processing::storage_t 
-spectrum::Processing::getpfftValues() {
-    return this->_peekValues(this->pstorage, 0, this->pstorage.size());
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::filter(const std::vector<T>& taps, int threads) {
+    if (taps.empty())
+        this->_terminate(BAD_TAPS);
+
+    if (!BasicPlan<T>::getShared(FastFIR<T>::getCheapestSize(taps.size()), 
+                                 this->backend)->isValid())
+        this->_terminate(BAD_ALLOCATE);
+
+    this->_detach();
+
+    if (threads < 1)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    /* Every channel is cut into parts so that there is a part per thread,
+     * a part is filtered after the L - 1 frames before it */
+    const int N = this->getFramesPerChannel();
+    const int parts = std::max(1, std::min(threads / this->getChannels(), 
+                                           N / (int)taps.size() / 16));
+    const int size = (N + parts - 1) / parts;
+    std::vector<std::vector<T>> filtered(this->getChannels(), std::vector<T>(N));
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    
+    /* The threads take the parts one after the other, 
+     * part k is the part k % parts of the channel k / parts */
+    for (int t = 0; t < std::min(threads, parts * this->getChannels()); t++) {
+        workers.push_back(std::thread([&]() {
+            FastFIR<T> fir(taps, 0, this->backend);
+            std::vector<T> skipped(taps.size() - 1);
+            
+            for (int k = next++; k < parts * this->getChannels(); k = next++) {
+                const int i = k / parts;
+                const T* x = this->file->samples[i].data();
+                const int beg = k % parts * size, end = std::min(N, beg + size);
+                const int history = std::min<int>(beg, taps.size() - 1);
+                
+                fir.reset();
+                fir.process(x + beg - history, history, skipped.data());
+                fir.process(x + beg, std::max(0, end - beg), filtered[i].data() + beg);
+            }
+        }));
+    }
+    for (std::thread& w : workers)
+        w.join();
+    
+    for (int i = 0; i < this->getChannels(); i++)
+        this->file->samples[i].swap(filtered[i]);
 };
 
-spectrum::Processing::storage_t 
-spectrum::Processing::getpfftValues(int channel) {
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::ISTFT(const storage_t& frames, int threads) {
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    
+    if (frames.empty())
+        this->_terminate(EMPTY_CONTAINER);
+
+    /* The spectra of each channel, in order of their first frame */
+    std::vector<std::vector<int>> spectra(this->getChannels());
+    for (int j = 0; j < (int)frames.size(); j++) {
+        const int channel = frames[j].channel;
+        const int beg = std::lround(frames[j].firstFreq / this->getFreqPerBin());
+        
+        if (channel >= this->getChannels() || channel < 0)
+            this->_terminate(BAD_CHANNEL);
+        
+        if (std::abs(frames[j].freqPerBin - this->getFreqPerBin()) > 1e-3f * this->getFreqPerBin() 
+                || beg < 0 || beg + (int)frames[j].values.size() > this->NFFT / 2 + 1)
+            this->_terminate(BAD_SPECTRA);
+        
+        spectra[channel].push_back(j);
+    }
+    for (std::vector<int>& s : spectra) {
+        std::stable_sort(s.begin(), s.end(), [&](int a, int b) { 
+            return frames[a].frame < frames[b].frame; 
+        });
+    }
+
+    if (!BasicPlan<T>::getShared(this->NFFT, this->backend)->isValid())
+        this->_terminate(BAD_ALLOCATE);
+    
+    this->_detach();
+
+    if (threads < 1)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    /* Hann synthesis window, not zero at its ends */
+    std::vector<T> window(this->NFFT);
+    for (int n = 0; n < this->NFFT; n++)
+        window[n] = 0.5 - 0.5 * std::cos(2 * pi * (n + 0.5) / this->NFFT);
+
+    /* Every channel is cut into parts so that there is a part per thread, 
+     * a part adds the windows overlapping it */
+    const int N = this->getFramesPerChannel();
+    const int parts = std::max(1, std::min(threads / this->getChannels(), N / this->NFFT / 16));
+    const int size = (N + parts - 1) / parts;
+    std::vector<std::vector<T>> resynthesized(this->getChannels());
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    
+    for (int i = 0; i < this->getChannels(); i++) {
+        if (!spectra[i].empty())
+            resynthesized[i].resize(N);
+    }
+    
+    /* The threads take the parts one after the other, 
+     * part k is the part k % parts of the channel k / parts */
+    for (int t = 0; t < std::min(threads, parts * this->getChannels()); t++) {
+        workers.push_back(std::thread([&]() {
+            /* The plan of the worker thread, 
+             * the one checked above is the plan of the calling thread */
+            std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(this->NFFT, 
+                                                                         this->backend);
+            if (!plan->isValid())
+                this->_terminate(BAD_ALLOCATE);
+            
+            std::vector<cpx_t> spectrum(this->NFFT / 2 + 1);
+            std::vector<T> timedata(this->NFFT);
+            std::vector<T> sum(size), weight(size);
+            
+            for (int k = next++; k < parts * this->getChannels(); k = next++) {
+                const std::vector<int>& s = spectra[k / parts];
+                const int beg = k % parts * size, end = std::min(N, beg + size);
+                
+                if (s.empty() || beg >= end)
+                    continue;
+                
+                std::fill(sum.begin(), sum.end(), 0);
+                std::fill(weight.begin(), weight.end(), 0);
+                
+                /* The first window ending after the beginning of the part */
+                std::vector<int>::const_iterator j = std::lower_bound(s.begin(), s.end(), 
+                        beg - this->NFFT + 1, [&](int a, int frame) { 
+                    return frames[a].frame < frame; 
+                });
+                
+                for (; j != s.end() && frames[*j].frame < end; j++) {
+                    const Keepeth<std::vector<cpx_t>, std::vector<T>>& f = frames[*j];
+                    const int first = std::lround(f.firstFreq / this->getFreqPerBin());
+                    
+                    /* The bins out of the band of the spectrum are zero */
+                    std::fill(spectrum.begin(), spectrum.end(), cpx_t{0, 0});
+                    std::copy(f.values.begin(), f.values.end(), spectrum.begin() + first);
+                    plan->fftri(spectrum.data(), timedata.data());
+                    
+                    const int n0 = std::max(beg, f.frame), n1 = std::min(end, f.frame + this->NFFT);
+                    for (int n = n0; n < n1; n++) {
+                        const T w = window[n - f.frame];
+                        sum[n - beg] += w * timedata[n - f.frame] / this->NFFT;
+                        weight[n - beg] += w;
+                    }
+                }
+                
+                T* out = resynthesized[k / parts].data() + beg;
+                for (int n = 0; n < end - beg; n++)
+                    out[n] = weight[n] > 0 ? sum[n] / weight[n] : 0;
+            }
+        }));
+    }
+    for (std::thread& w : workers)
+        w.join();
+    
+    for (int i = 0; i < this->getChannels(); i++) {
+        if (!spectra[i].empty())
+            this->file->samples[i].swap(resynthesized[i]);
+    }
+};
+
+template<typename T>
+bool 
+spectrum::BasicProcessing<T>::save(const char* path) {
+    this->_wait();
+    return this->file->save(path);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::getfftValues() {
+    return this->_peekValues(this->storage);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::getpfftValues() {
+    return this->_peekValues(this->pstorage);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::getpfftValues(int channel) {
+    if (channel >= this->getChannels() || channel < 0)
+        this->_terminate(BAD_CHANNEL);
+    
+    /* The entries of the channel, in the order of the calls */ 
+    return this->_peekValues(this->pstorage, channel);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::getsfftValues() {
+    return this->_peekValues(this->sstorage);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::getsfftValues(int channel) {
     if (channel >= this->getChannels() || channel < 0)
         this->_terminate(BAD_CHANNEL);
     
-    /* Due to the fact that each channel has the same number of samples, 
-     * we calculate the number of samples per channel, 
-     * then shift along the original vector, 
-     * return the range of values of the desired channel */ 
-    const int binsPerChannel = this->pstorage.size() / this->getChannels();
-    return this->_peekValues(this->pstorage, channel * binsPerChannel,
-                                             (channel + 1) * binsPerChannel);
+    return this->_peekValues(this->sstorage, channel);
 };
 
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::FFT() {
+    this->FFT(0, this->getSampleRate() / 2.0f);
+};
+
+template<typename T>
 void 
-spectrum::Processing::FFT() {
-    kiss_fftr_cfg cfg = kiss_fftr_alloc(this->NFFT, false, 0, 0);
+spectrum::BasicProcessing<T>::FFT(float fmin, float fmax) {
+    this->_wait();
+
+    std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(this->NFFT, this->backend);
      
-    if (!cfg)
+    if (!plan->isValid())
         this->_terminate(BAD_ALLOCATE);
     
+    /* Every entry keeps its own band, 
+     * the calls may ask for different ones */
+    int beg, bins;
+    this->_band(fmin, fmax, beg, bins);
+    std::vector<cpx_t> spectrum(bins < this->NFFT / 2 + 1 ? this->NFFT / 2 + 1 : 0);
+    
     for (int i = 0; i < this->getChannels(); i++) {
         /* Creating a structure object that contains all the necessary 
          * properties for storing conversion values 
          * at a (j/timeScale) moment in time, 
          * allocating memory for arrays of FFT values */
         this->storage.push_back(
-                    Keepeth<std::unique_ptr<kiss_fft_cpx>, 
-                            std::unique_ptr<kiss_fft_scalar>>
+                    Keepeth<std::unique_ptr<cpx_t[]>, 
+                            std::unique_ptr<T[]>>
                             (i, this->getFreqPerBin(), -1, 
-                            std::unique_ptr<kiss_fft_cpx>(new kiss_fft_cpx[this->NFFT / 2 + 1]),
-                            std::unique_ptr<kiss_fft_scalar>(new kiss_fft_scalar[this->NFFT / 2 + 1]))
+                            std::unique_ptr<cpx_t[]>(new cpx_t[bins]),
+                            std::unique_ptr<T[]>(new T[bins]), 
+                            beg * this->getFreqPerBin(), 0, bins)
         ); 
-        /* Doing FFT for each channel of the audio file */
-        kiss_fftr(cfg, this->file.samples[i].data(), this->storage[i].values.get());
+        /* Doing FFT for each channel of the audio file, 
+         * only the bins of the band are kept */
+        this->_fftr(*plan, this->file->samples[i].data(), spectrum, 
+                    this->storage.back().values.get(), beg, bins);
     
         /* FFT normalization to db */
         this->scale(
-                this->storage[i].values.get(), 
-                this->storage[i].scaledValues.get()
+                this->storage.back().values.get(), 
+                this->storage.back().scaledValues.get(),
+                bins
         );
     }
-    kiss_fft_free(cfg);
 };
 
+template<typename T>
 void 
-spectrum::Processing::pFFT(int timeScale) {
-    kiss_fftr_cfg cfg = kiss_fftr_alloc(this->NFFT, false, 0, 0);
+spectrum::BasicProcessing<T>::pFFT(int timeScale) {
+    this->pFFT(timeScale, 0, this->getSampleRate() / 2.0f);
+};
 
-    if (!cfg)
-        this->_terminate(BAD_ALLOCATE);
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::pFFT(int timeScale, float fmin, float fmax) {
+    _pFFT({this}, timeScale, fmin, fmax);
+};
 
-    if (timeScale < 1 || timeScale > 1000 )
-        this->_terminate(BAD_TIMESCALE);
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::pFFT(const std::vector<BasicProcessing*>& configurations, 
+                                   int timeScale) {
+    if (configurations.empty())
+        return;
+
+    _pFFT(configurations, timeScale, 0, configurations[0]->getSampleRate() / 2.0f);
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::_pFFT(const std::vector<BasicProcessing*>& configurations, 
+                                    int timeScale, float fmin, float fmax) {
+    BasicProcessing* first = configurations[0];
+    std::vector<std::shared_ptr<BasicPlan<T>>> plans;
+    std::vector<std::vector<cpx_t>> spectra;
+    std::vector<int> begs, bins;
+    int NFFT = 0;
+
+    for (BasicProcessing* c : configurations) {
+        plans.push_back(BasicPlan<T>::getShared(c->NFFT, c->backend));
+
+        if (!plans.back()->isValid())
+            c->_terminate(BAD_ALLOCATE);
+
+        if (timeScale < 1 || timeScale > 1000 )
+            c->_terminate(BAD_TIMESCALE);
+
+        if (c->file != first->file)
+            c->_terminate(BAD_SHARED);
+        
+        begs.push_back(0);
+        bins.push_back(0);
+        c->_band(fmin, fmax, begs.back(), bins.back());
+        spectra.push_back(std::vector<cpx_t>(bins.back() < c->NFFT / 2 + 1 
+                                             ? c->NFFT / 2 + 1 : 0));
+        NFFT = std::max(NFFT, c->NFFT);
+    }
     
     /* Performing FFT for j-th moment of time 
      * (a moment of time an audio file is equal 
      * to the: */
-    const int segment = this->getSampleRate() / timeScale;
+    const int segment = first->getSampleRate() / timeScale;
+    const std::vector<std::vector<T>>& samples = first->file->samples;
+    
+    /* The window of the largest configuration, 
+     * the others transform its first frames */
+    std::vector<T> v(NFFT);
      
     /* i - iterated by channels, 
-     * k - iterator for the storage of FFT values, 
-     * in which the FFT of each channel is stored sequentially 
-     * (one after the other), 
-     * j - iterated by frames of a particular channel */
-    for (int i = 0, k = 0; i < this->getChannels(); i++) {
+     * j - iterated by frames of a particular channel, 
+     * the FFT of each channel is stored sequentially 
+     * (one after the other) */
+    for (int i = 0; i < first->getChannels(); i++) {
         /* The more we divide one second, the more total values of time moments 
          * we have. The final size of the array is found as the duration 
          * of the audio file * timeScale */
-        for (int j = 0; (float)j < this->getFileDuration() * timeScale; j++,k++) { 
+        for (int j = 0; (float)j < first->getFileDuration() * timeScale; j++) { 
             
-            /* Creating a structure object that contains all the necessary 
-             * properties for storing conversion values 
-             * at a (j/timeScale) moment in time, 
-             * allocating memory for arrays of FFT values */
-            this->pstorage.push_back(
-                    Keepeth<std::unique_ptr<kiss_fft_cpx>, 
-                            std::unique_ptr<kiss_fft_scalar>>
-                            (i, this->getFreqPerBin(), (float)j / timeScale, 
-                            std::unique_ptr<kiss_fft_cpx>(new kiss_fft_cpx[this->NFFT / 2 + 1]),
-                            std::unique_ptr<kiss_fft_scalar>(new kiss_fft_scalar[this->NFFT / 2 + 1]))
-            );
+            /* We select the window of the frames of the audio file 
+             * for which the FFT will be performed, 
+             * zero padded past the end of the channel */
+            const int frame = segment * j;
+            const int n = std::max(0, std::min(NFFT, (int)samples[i].size() - frame));
             
-            /* We select the segment of the audio file 
-             * for which the FFT will be performed */
-            std::vector<float> v(
-                    this->file.samples[i].data() + (segment * j), 
-                    this->file.samples[i].data() + (segment * (j + 1))
+            /* With the read-ahead only the frames of the window 
+             * have to be decoded, the next ones are being read */
+            first->_wait(frame + n);
+            
+            std::copy(samples[i].begin() + frame, samples[i].begin() + frame + n, v.begin());
+            std::fill(v.begin() + n, v.end(), 0);
+            
+            for (int c = 0; c < (int)configurations.size(); c++) {
+                BasicProcessing* p = configurations[c];
+                
+                /* Creating a structure object that contains all the necessary 
+                 * properties for storing conversion values 
+                 * at a (j/timeScale) moment in time, 
+                 * allocating memory for arrays of FFT values */
+                p->pstorage.push_back(
+                        Keepeth<std::unique_ptr<cpx_t[]>, 
+                                std::unique_ptr<T[]>>
+                                (i, p->getFreqPerBin(), (float)j / timeScale, 
+                                std::unique_ptr<cpx_t[]>(new cpx_t[bins[c]]),
+                                std::unique_ptr<T[]>(new T[bins[c]]), 
+                                begs[c] * p->getFreqPerBin(), frame, bins[c])
+                );
+                
+                p->_fftr(*plans[c], v.data(), spectra[c], 
+                         p->pstorage.back().values.get(), begs[c], bins[c]);
+     
+                /* FFT normalization to db */
+                p->scale(
+                        p->pstorage.back().values.get(), 
+                        p->pstorage.back().scaledValues.get(),
+                        bins[c]
+                );
+            }
+        }
+    }
+};
+
+template<typename T>
+std::vector<T> 
+spectrum::BasicProcessing<T>::detect(const std::vector<float>& frequencies, 
+                                     int timeScale, int channel) {
+    this->_wait();
+
+    if (timeScale < 1 || timeScale > 1000 )
+        this->_terminate(BAD_TIMESCALE);
+
+    if (channel >= this->getChannels() || channel < 0)
+        this->_terminate(BAD_CHANNEL);
+    
+    for (float f : frequencies) {
+        if (f < 0 || f > this->getSampleRate() / 2.0f)
+            this->_terminate(BAD_FREQUENCY);
+    }
+
+    Goertzel<T> goertzel(frequencies, this->getSampleRate());
+    
+    const int K = frequencies.size();
+    const int segment = this->getSampleRate() / timeScale;
+    const std::vector<T>& samples = this->file->samples[channel];
+    
+    std::vector<T> magnitudes;
+    for (int j = 0; (float)j < this->getFileDuration() * timeScale; j++) {
+        /* The last time points have less than NFFT frames,
+         * as if they were zero padded */
+        const int frame = segment * j;
+        const int n = std::max(0, std::min(this->NFFT, (int)samples.size() - frame));
+        
+        magnitudes.resize((j + 1) * K);
+        goertzel.magnitudes(samples.data() + frame, n, magnitudes.data() + j * K);
+    }
+    return magnitudes;
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::sFFT(int hop) {
+    this->_wait();
+
+    if (hop < 1 || hop > this->NFFT)
+        this->_terminate(BAD_HOP);
+
+    SlidingDFT<T> sdft(this->NFFT, 0, this->backend);
+
+    if (!sdft.isValid())
+        this->_terminate(BAD_ALLOCATE);
+    
+    for (int i = 0; i < this->getChannels(); i++) {
+        const std::vector<T>& samples = this->file->samples[i];
+        
+        /* j - the first frame of the window, 
+         * the window is slid to the end of the channel */
+        for (int j = 0; j + this->NFFT <= (int)samples.size(); j += hop) {
+            if (j == 0)
+                sdft.reset(samples.data());
+            else {
+                for (int n = j - hop; n < j; n++)
+                    sdft.push(samples[n + this->NFFT]);
+            }
+
+            this->sstorage.push_back(
+                    Keepeth<std::unique_ptr<cpx_t[]>, 
+                            std::unique_ptr<T[]>>
+                            (i, this->getFreqPerBin(), (float)j / this->getSampleRate(), 
+                            std::unique_ptr<cpx_t[]>(new cpx_t[this->NFFT / 2 + 1]),
+                            std::unique_ptr<T[]>(new T[this->NFFT / 2 + 1]), 
+                            0, j, this->NFFT / 2 + 1)
             );
+
+            sdft.values(this->sstorage.back().values.get());
             
-            kiss_fftr(cfg, v.data(), this->pstorage[k].values.get());
- 
             /* FFT normalization to db */
             this->scale(
-                    this->pstorage[k].values.get(), 
-                    this->pstorage[k].scaledValues.get()
+                    this->sstorage.back().values.get(), 
+                    this->sstorage.back().scaledValues.get(),
+                    this->NFFT / 2 + 1
             );
         }
     }
-    kiss_fft_free(cfg);
 };
 
+template<typename T>
 void 
-spectrum::Processing::scale(kiss_fft_cpx* fft, kiss_fft_scalar* scaled) {
-    for (int i = 0; i < this->NFFT / 2 + 1; i++) {
-        scaled[i] = this->_scaleExpression(fft[i].r, fft[i].i);
+spectrum::BasicProcessing<T>::_band(float fmin, float fmax, int& beg, int& bins) {
+    if (fmin < 0 || fmin >= fmax || fmax > this->getSampleRate() / 2.0f)
+        this->_terminate(BAD_BAND);
+
+    /* The bins whose frequencies are in [fmin, fmax], 
+     * a band edge on a bin (up to the round-off) includes it */
+    const double bin = (double)this->NFFT / this->getSampleRate();
+    beg = (int)std::ceil(fmin * bin - 1e-6);
+    bins = std::min((int)std::floor(fmax * bin + 1e-6), this->NFFT / 2) - beg + 1;
+    
+    if (bins < 1)
+        this->_terminate(BAD_BAND);
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::_fftr(BasicPlan<T>& plan, const T* timedata, 
+                                    std::vector<cpx_t>& spectrum, 
+                                    cpx_t* freqdata, const int beg, const int bins) {
+    /* The full spectrum is computed in place, 
+     * a band is computed to the spectrum buffer then copied */
+    if (spectrum.empty())
+        return plan.fftr(timedata, freqdata);
+    
+    plan.fftr(timedata, spectrum.data());
+    std::copy(spectrum.begin() + beg, spectrum.begin() + beg + bins, freqdata);
+};
+
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::zoomFFT(float fmin, float fmax, float resolution) {
+    this->_wait();
+
+    if (fmin < 0 || fmin >= fmax || fmax > this->getSampleRate() / 2.0f || resolution <= 0)
+        this->_terminate(BAD_BAND);
+
+    Zoom<T> zoom(fmin, fmax, resolution, this->getSampleRate());
+
+    if (!zoom.isValid())
+        this->_terminate(BAD_ALLOCATE);
+    
+    storage_t r;
+    for (int i = 0; i < this->getChannels(); i++) {
+        std::vector<cpx_t> values(zoom.getSize());
+        std::vector<T> scaledValues(zoom.getSize());
+        
+        zoom.transform(this->file->samples[i].data(), this->file->samples[i].size(), 
+                       values.data());
+        
+        /* FFT normalization to db */
+        this->scale(values.data(), scaledValues.data(), zoom.getSize());
+        
+        r.push_back(Keepeth<std::vector<cpx_t>, std::vector<T>>(
+                    i, zoom.getFreqPerBin(), -1, 
+                    std::move(values), std::move(scaledValues), zoom.getFirstFreq(), 
+                    0, zoom.getSize())
+        );
     }
+    return r;
 };
 
-float 
-spectrum::Processing::_scaleExpression(float r, float i) {
-    /*                  x = sqrt(r^2 +i^2)
-     * Distance between two points (Euclidean distance) 
-     * calculated by Pythagorean theorem
-     * 
-     * We use the standard transformation - 20 * log10(x)
-     * 
-     * Then we sum the resulting number with the number 
-     * mean the dynamic range (for the current "depth" of quantization)
-     * 
-     * Now the maximum amplitude is 0 = -96.33 + 96.33
-     * 
-     * Then divide by the same number, bringing all values from -inf to 1.0f, multiply by 100 */
-    return (((20.0f * log10f(std::sqrt(std::pow(r, 2.0f) + std::pow(i, 2.0f))) + (-1 * this->dynamicRange)) / this->dynamicRange)) * 100;
+template<typename T>
+std::vector<T> 
+spectrum::BasicProcessing<T>::constantQ(float fmin, float fmax, int binsPerOctave, 
+                                        int timeScale, int channel) {
+    this->_wait();
+
+    if (fmin <= 0 || fmin >= fmax || fmax > this->getSampleRate() / 2.0f)
+        this->_terminate(BAD_BAND);
+
+    if (binsPerOctave < 1)
+        this->_terminate(BAD_BINS);
+
+    if (timeScale < 1 || timeScale > 1000 )
+        this->_terminate(BAD_TIMESCALE);
+
+    if (channel >= this->getChannels() || channel < 0)
+        this->_terminate(BAD_CHANNEL);
+
+    ConstantQ<T> cq(this->getSampleRate(), fmin, fmax, binsPerOctave);
+    
+    if (!cq.isValid())
+        this->_terminate(BAD_ALLOCATE);
+    
+    const int K = cq.getSize();
+    const int N = cq.getNFFT();
+    const int segment = this->getSampleRate() / timeScale;
+    const std::vector<T>& samples = this->file->samples[channel];
+    
+    std::vector<T> window(N);
+    std::vector<cpx_t> values(K);
+    std::vector<T> magnitudes;
+    
+    for (int j = 0; (float)j < this->getFileDuration() * timeScale; j++) {
+        const int frame = segment * j;
+        const int n = std::max(0, std::min(N, (int)samples.size() - frame));
+        
+        std::copy(samples.begin() + frame, samples.begin() + frame + n, window.begin());
+        std::fill(window.begin() + n, window.end(), 0);
+        cq.transform(window.data(), values.data());
+        
+        for (int k = 0; k < K; k++)
+            magnitudes.push_back(std::sqrt(values[k].r * values[k].r + values[k].i * values[k].i));
+    }
+    return magnitudes;
 };
 
 template<typename T>
 std::vector<T> 
-spectrum::Processing::_getVector(const T* t, const int S) {
-    /* Copy to the std::vector the values indicated by the pointers 
-     * of the beginning and end of the array, then return this std::vector */
-    return std::move(std::vector<T> (t, t + S));
+spectrum::BasicProcessing<T>::mel(int filters, float fmin, float fmax, 
+                                  int timeScale, int channel) {
+    return this->_mel(filters, 0, fmin, fmax, timeScale, channel);
 };
 
-spectrum::Processing::storage_t 
-spectrum::Processing::_peekValues(lstorage_t& s, const int beg, const int end) {
-    if (s.empty()) 
+template<typename T>
+std::vector<T> 
+spectrum::BasicProcessing<T>::mfcc(int filters, int coefficients, float fmin, float fmax, 
+                                   int timeScale, int channel) {
+    if (coefficients < 1)
+        this->_terminate(BAD_FILTERS);
+
+    return this->_mel(filters, coefficients, fmin, fmax, timeScale, channel);
+};
+
+template<typename T>
+std::vector<T> 
+spectrum::BasicProcessing<T>::_mel(int filters, int coefficients, float fmin, float fmax, 
+                                   int timeScale, int channel) {
+    this->_wait();
+
+    std::shared_ptr<BasicPlan<T>> plan = BasicPlan<T>::getShared(this->NFFT, this->backend);
+
+    if (!plan->isValid())
+        this->_terminate(BAD_ALLOCATE);
+
+    if (fmin < 0 || fmin >= fmax || fmax > this->getSampleRate() / 2.0f)
+        this->_terminate(BAD_BAND);
+
+    if (filters < 1 || coefficients > filters)
+        this->_terminate(BAD_FILTERS);
+
+    if (timeScale < 1 || timeScale > 1000 )
+        this->_terminate(BAD_TIMESCALE);
+
+    if (channel >= this->getChannels() || channel < 0)
+        this->_terminate(BAD_CHANNEL);
+
+    Mel<T> bank(this->NFFT, this->getSampleRate(), filters, coefficients, fmin, fmax);
+    
+    const int K = coefficients > 0 ? coefficients : filters;
+    const int segment = this->getSampleRate() / timeScale;
+    const std::vector<T>& samples = this->file->samples[channel];
+    
+    std::vector<T> window(this->NFFT);
+    std::vector<cpx_t> spectrum(this->NFFT / 2 + 1);
+    std::vector<T> features;
+    
+    for (int j = 0; (float)j < this->getFileDuration() * timeScale; j++) {
+        const int frame = segment * j;
+        const int n = std::max(0, std::min(this->NFFT, (int)samples.size() - frame));
+        
+        std::copy(samples.begin() + frame, samples.begin() + frame + n, window.begin());
+        std::fill(window.begin() + n, window.end(), 0);
+        plan->fftr(window.data(), spectrum.data());
+        
+        features.resize(features.size() + K);
+        if (coefficients > 0)
+            bank.mfcc(spectrum.data(), features.data() + j * K);
+        else
+            bank.energies(spectrum.data(), features.data() + j * K);
+    }
+    return features;
+};
+
+template<typename T>
+std::vector<T> 
+spectrum::BasicProcessing<T>::delays(bool phat, float maxDelay) {
+    if (this->pstorage.empty())
         this->_terminate(EMPTY_CONTAINER);
-    storage_t r; 
-
-    for (int i = beg; i < end; i++) {
-        r.push_back(Keepeth<std::vector<kiss_fft_cpx>, std::vector<float>>(
-                    s[i].channel, 
-                    s[i].freqPerBin,
-                    s[i].time, 
-                    this->_getVector<kiss_fft_cpx>(s[i].values.get(), this->NFFT / 2 + 1),
-                    this->_getVector<float>(s[i].scaledValues.get(), this->NFFT / 2 + 1)
-            )
-        );
+
+    if (this->getChannels() < 2)
+        this->_terminate(BAD_CHANNEL);
+
+    /* The whole spectra of every channel, in the order of the calls, 
+     * each channel needs one for every time point */
+    std::vector<std::vector<const cpx_t*>> channels(this->getChannels());
+    for (const auto& e : this->pstorage) {
+        if (e.bins != this->NFFT / 2 + 1)
+            this->_terminate(BAD_SPECTRA);
+        channels[e.channel].push_back(e.values.get());
+    }
+    
+    for (const auto& c : channels) {
+        if (c.size() != channels[0].size())
+            this->_terminate(BAD_SPECTRA);
     }
 
-    return std::move(r);
+    CrossCorrelation<T> correlation(this->NFFT, this->getChannels(), phat, 
+                                    std::lround(maxDelay * this->getSampleRate()));
+    
+    if (!correlation.isValid())
+        this->_terminate(BAD_ALLOCATE);
+    
+    const int P = correlation.getPairs();
+    const int points = channels[0].size();
+    std::vector<const cpx_t*> spectra(this->getChannels());
+    std::vector<T> delays(points * P);
+    
+    for (int j = 0; j < points; j++) {
+        for (int i = 0; i < this->getChannels(); i++)
+            spectra[i] = channels[i][j];
+        
+        correlation.delays(spectra.data(), delays.data() + j * P);
+        for (int p = 0; p < P; p++)
+            delays[j * P + p] /= this->getSampleRate();
+    }
+    return delays;
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::scale(cpx_t* fft, T* scaled, const int S) {
+    for (int i = 0; i < S; i++) {
+        scaled[i] = this->_scaleExpression(fft[i].r, fft[i].i);
+    }
+};
+
+template<typename T>
+T 
+spectrum::BasicProcessing<T>::_scaleExpression(T r, T i) {
+    /* See spectrum::scaleValue() */
+    return spectrum::scaleValue(r, i, this->dynamicRange);
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::_wait(int frames) {
+    if (this->reader)
+        this->reader->wait(frames);
 };
 
+template<typename T>
 void 
-spectrum::Processing::_terminate(const char* exitMessage) {
-    std::cerr << "Error : " << exitMessage << std::endl;
-    return exit(1);
+spectrum::BasicProcessing<T>::_detach() {
+    this->_wait();
+    if (this->file.use_count() > 1)
+        this->file.reset(new AudioFile<T>(*this->file));
 };
 
+template<typename T>
+typename spectrum::BasicProcessing<T>::storage_t 
+spectrum::BasicProcessing<T>::_peekValues(lstorage_t& s, const int channel) {
+    if (s.empty()) 
+        this->_terminate(EMPTY_CONTAINER);
+
+    return spectrum::peekValues<storage_t>(s, 0, s.size(), channel);
+};
+
+template<typename T>
+void 
+spectrum::BasicProcessing<T>::_terminate(const char* exitMessage) {
+    return spectrum::terminate(exitMessage);
+};
+
+template class spectrum::BasicProcessing<float>;
+template class spectrum::BasicProcessing<double>;
+
 std::ostream& 
 operator<<(std::ostream& os, kiss_fft_cpx const& k) {
     /* In future move to spectrum::Export */
     return os << k.r << ';' << k.i;
 };
+
+std::ostream& 
+operator<<(std::ostream& os, kiss_fft_f64_cpx const& k) {
+    return os << k.r << ';' << k.i;
+};
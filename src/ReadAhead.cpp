@@ -0,0 +1,92 @@
+#include "ReadAhead.h"
+#include "PCMFile.h"
+#include <fstream>
+#include <limits>
+#include <vector>
+
+/* Frames read and decoded at once by the thread */
+#define READ_AHEAD_BLOCK 16384
+
+template<typename T>
+spectrum::ReadAhead<T>::ReadAhead()
+    : frames(0),
+    finished(true),
+    stop(false) {};
+
+template<typename T>
+spectrum::ReadAhead<T>::~ReadAhead() {
+    this->stop = true;
+    if (this->thread.joinable())
+        this->thread.join();
+};
+
+template<typename T>
+bool
+spectrum::ReadAhead<T>::start(const char* FILE, std::shared_ptr<AudioFile<T>> file) {
+    std::shared_ptr<std::ifstream> in(new std::ifstream(FILE, std::ios::binary));
+    PCMFormat f;
+
+    if (!readPCMFormat(*in, f) || f.frames > (size_t)std::numeric_limits<int>::max())
+        return false;
+
+    file->setNumChannels(f.channels);
+    file->setNumSamplesPerChannel(f.frames);
+    file->setSampleRate(f.sampleRate);
+    file->setBitDepth(f.bitDepth);
+    
+    this->frames = 0;
+    this->finished = false;
+    
+    this->thread = std::thread([this, in, file, f]() {
+        const int bytes = f.bitDepth / 8;
+        const T scale = 1 / (T)2147483648.0;
+        std::vector<unsigned char> block((size_t)READ_AHEAD_BLOCK * f.blockAlign);
+        size_t n0 = 0;
+        
+        while (n0 < f.frames && !this->stop) {
+            const size_t n = std::min<size_t>(READ_AHEAD_BLOCK, f.frames - n0);
+            if (!in->read((char*)block.data(), n * f.blockAlign))
+                break;
+            
+            for (int i = 0; i < f.channels; i++) {
+                T* samples = file->samples[i].data() + n0;
+                for (size_t j = 0; j < n; j++)
+                    samples[j] = decodePCMSample(block.data() + j * f.blockAlign + i * bytes, 
+                                                 bytes) * scale;
+            }
+            n0 += n;
+            
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->frames = n0;
+            }
+            this->decoded.notify_all();
+        }
+        
+        /* The frames that could not be read stay zero */
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->finished = true;
+        }
+        this->decoded.notify_all();
+    });
+    return true;
+};
+
+template<typename T>
+void
+spectrum::ReadAhead<T>::wait(int frames) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->decoded.wait(lock, [this, frames]() { 
+        return this->finished || this->frames >= frames; 
+    });
+};
+
+template<typename T>
+void
+spectrum::ReadAhead<T>::wait() {
+    this->wait(std::numeric_limits<int>::max());
+};
+
+template class spectrum::ReadAhead<float>;
+template class spectrum::ReadAhead<double>;
@@ -0,0 +1,191 @@
+#include "Resampler.h"
+#include "Simd.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <utility>
+
+/* Filter taps per phase, Blackman window, as DECIMATOR_TAPS:
+ * the transition band is about 5.5 / RESAMPLER_TAPS of the lower rate,
+ * the stopband attenuation about 74 dB */
+#define RESAMPLER_TAPS 48
+/* The number of filter banks kept for the next objects, as CQ_CACHE: 
+ * the least recently used one is dropped (the objects using it keep it) */
+#define RESAMPLER_CACHE 8
+
+static int
+_gcd(int a, int b) {
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+};
+
+template<typename T>
+spectrum::Resampler<T>::Resampler(int inRate, int outRate)
+    : bank(_bank(outRate / _gcd(inRate, outRate), inRate / _gcd(inRate, outRate))),
+    buffer(this->bank->K - 1),
+    frames(0),
+    next(0) {};
+
+template<typename T>
+spectrum::Resampler<T>::~Resampler() {};
+
+template<typename T>
+int
+spectrum::Resampler<T>::getUp() {
+    return this->bank->L;
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::getDown() {
+    return this->bank->M;
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::getSize(int N) {
+    return ((long long)N * this->bank->L + this->bank->M - 1) / this->bank->M;
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::getPending() {
+    const Bank& b = *this->bank;
+    return (this->frames * b.L + b.M - 1) / b.M - this->next;
+};
+
+template<typename T>
+void
+spectrum::Resampler<T>::reset() {
+    this->buffer.assign(this->bank->K - 1, 0);
+    this->frames = 0;
+    this->next = 0;
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::process(const T* samples, const int N, T* out) {
+    return this->_run(samples, N, out, std::numeric_limits<long long>::max());
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::flush(T* out) {
+    const Bank& b = *this->bank;
+    const long long last = this->next + this->getPending();
+    
+    /* The zeros after the signal up to the frames of the last output */
+    const long long end = last > 0 ? ((last - 1) * b.M + b.half) / b.L + 1 : 0;
+    const std::vector<T> zeros(std::max(0LL, end - this->frames));
+    
+    const int n = this->_run(zeros.data(), zeros.size(), out, last);
+    this->reset();
+    return n;
+};
+
+template<typename T>
+int
+spectrum::Resampler<T>::_run(const T* samples, const int N, T* out, long long last) {
+    const Bank& b = *this->bank;
+    const int K = b.K;
+    
+    /* The frame n of the signal is buffer[n - base] */
+    const long long base = this->frames - (K - 1);
+    this->buffer.resize(K - 1 + N);
+    std::copy(samples, samples + N, this->buffer.begin() + K - 1);
+    this->frames += N;
+    
+    int Y = 0;
+    for (; this->next < last; this->next++, Y++) {
+        /* The m-th output is the frame t = m * M + half of the filtered 
+         * upsampled signal, t = n0 * L + p: the p-th phase 
+         * reads the input frames n0 - K + 1 to n0, 
+         * the outputs of the next chunks need its frames */
+        const long long t = this->next * b.M + b.half;
+        if (t / b.L >= this->frames)
+            break;
+        
+        const int p = t % b.L;
+        const T* h = b.taps.data() + p * K;
+        const T* x = this->buffer.data() + (t / b.L - K + 1 - base);
+        out[Y] = simd::dot(h, x, K);
+    }
+    
+    /* The K - 1 last frames for the next chunk */
+    std::copy(this->buffer.end() - (K - 1), this->buffer.end(), this->buffer.begin());
+    this->buffer.resize(K - 1);
+    return Y;
+};
+
+template<typename T>
+std::shared_ptr<const typename spectrum::Resampler<T>::Bank>
+spectrum::Resampler<T>::_bank(int L, int M) {
+    typedef std::pair<int, int> key_t;
+    static std::list<std::pair<key_t, std::shared_ptr<const Bank>>> cache;
+    static std::mutex mutex;
+    
+    const key_t key = std::make_pair(L, M);
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    /* The most recently used banks are the first ones */
+    for (auto i = cache.begin(); i != cache.end(); i++) {
+        if (i->first == key) {
+            cache.splice(cache.begin(), cache, i);
+            return cache.front().second;
+        }
+    }
+
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    std::shared_ptr<Bank> bank(new Bank());
+    
+    /* Windowed sinc low-pass filter at the upsampled rate, 
+     * the transition band ends at the half of the lower rate, 
+     * normalized to a gain of L at 0 Hz */
+    const int R = std::max(L, M);
+    const int length = L == 1 && M == 1 ? 1 : RESAMPLER_TAPS * R + 1;
+    const double fc = (0.5 - 2.75 / RESAMPLER_TAPS) / R;
+    std::vector<double> h(length, 1);
+    
+    if (length > 1) {
+        double sum = 0;
+        for (int l = 0; l < length; l++) {
+            const double t = l - (length - 1) / 2.0;
+            const double sinc = t == 0 ? 2 * fc : std::sin(2 * pi * fc * t) / (pi * t);
+            const double w = 0.42 - 0.5 * std::cos(2 * pi * l / (length - 1)) 
+                                  + 0.08 * std::cos(4 * pi * l / (length - 1));
+            h[l] = sinc * w;
+            sum += h[l];
+        }
+        for (int l = 0; l < length; l++)
+            h[l] *= L / sum;
+    }
+
+    bank->L = L;
+    bank->M = M;
+    bank->K = (length + L - 1) / L;
+    bank->half = (length - 1) / 2;
+    bank->taps.assign(L * bank->K, 0);
+
+    /* The k-th tap of the p-th phase is h[p + (K - 1 - k) * L] */
+    for (int p = 0; p < L; p++) {
+        for (int k = 0; k < bank->K; k++) {
+            const int l = p + (bank->K - 1 - k) * L;
+            if (l < length)
+                bank->taps[p * bank->K + k] = (T)h[l];
+        }
+    }
+
+    cache.emplace_front(key, bank);
+    if (cache.size() > RESAMPLER_CACHE)
+        cache.pop_back();
+    return bank;
+};
+
+template class spectrum::Resampler<float>;
+template class spectrum::Resampler<double>;
@@ -0,0 +1,77 @@
+#include "Ring.h"
+#include <algorithm>
+
+template<typename T>
+spectrum::Ring<T>::Ring(int capacity)
+    : buffer(),
+    mask([capacity]() {
+        size_t n = 1;
+        while ((int)n < capacity)
+            n *= 2;
+        return n - 1;
+    }()),
+    head(0),
+    tail(0)
+{
+    this->buffer.resize(this->mask + 1);
+};
+
+template<typename T>
+spectrum::Ring<T>::~Ring() {};
+
+template<typename T>
+int
+spectrum::Ring<T>::getCapacity() {
+    return (int)this->buffer.size();
+};
+
+template<typename T>
+int
+spectrum::Ring<T>::size() {
+    const size_t tail = this->tail.load(std::memory_order_acquire);
+    return (int)(this->head.load(std::memory_order_acquire) - tail);
+};
+
+template<typename T>
+int
+spectrum::Ring<T>::push(const T* values, int n) {
+    const size_t head = this->head.load(std::memory_order_relaxed);
+    const size_t tail = this->tail.load(std::memory_order_acquire);
+    
+    n = std::min(n, (int)(this->buffer.size() - (head - tail)));
+    if (n <= 0)
+        return 0;
+
+    /* The values are written in up to two pieces, 
+     * to the end of the buffer then from its beginning */
+    const size_t beg = head & this->mask;
+    const size_t first = std::min((size_t)n, this->buffer.size() - beg);
+    std::copy(values, values + first, this->buffer.begin() + beg);
+    std::copy(values + first, values + n, this->buffer.begin());
+    
+    this->head.store(head + n, std::memory_order_release);
+    return n;
+};
+
+template<typename T>
+int
+spectrum::Ring<T>::pop(T* values, int n) {
+    const size_t tail = this->tail.load(std::memory_order_relaxed);
+    const size_t head = this->head.load(std::memory_order_acquire);
+    
+    n = std::min(n, (int)(head - tail));
+    if (n <= 0)
+        return 0;
+
+    const size_t beg = tail & this->mask;
+    const size_t first = std::min((size_t)n, this->buffer.size() - beg);
+    std::copy(this->buffer.begin() + beg, this->buffer.begin() + beg + first, values);
+    std::copy(this->buffer.begin(), this->buffer.begin() + (n - first), values + first);
+    
+    this->tail.store(tail + n, std::memory_order_release);
+    return n;
+};
+
+template class spectrum::Ring<float>;
+template class spectrum::Ring<double>;
+template class spectrum::Ring<long long>;
@@ -0,0 +1,97 @@
+#include "SlidingDFT.h"
+#include <cmath>
+#include <algorithm>
+
+template<typename T>
+spectrum::SlidingDFT<T>::SlidingDFT(int NFFT, int resync, Backend backend)
+    : NFFT(NFFT),
+    resync(resync > 0 ? resync : NFFT),
+    count(0),
+    window(NFFT),
+    pos(0),
+    re(NFFT / 2 + 1),
+    im(NFFT / 2 + 1),
+    backend(backend),
+    linear(NFFT),
+    freq(NFFT / 2 + 1)
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+    for (int k = 0; k < NFFT / 2 + 1; k++) {
+        this->wr.push_back((T)std::cos(2 * pi * k / NFFT));
+        this->wi.push_back((T)std::sin(2 * pi * k / NFFT));
+    }
+};
+
+template<typename T>
+spectrum::SlidingDFT<T>::~SlidingDFT() {};
+
+template<typename T>
+int
+spectrum::SlidingDFT<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+bool
+spectrum::SlidingDFT<T>::isValid() {
+    return BasicPlan<T>::getShared(this->NFFT, this->backend)->isValid();
+};
+
+template<typename T>
+void
+spectrum::SlidingDFT<T>::reset(const T* samples) {
+    std::copy(samples, samples + this->NFFT, this->window.begin());
+    this->pos = 0;
+    this->_recompute();
+};
+
+template<typename T>
+void
+spectrum::SlidingDFT<T>::push(T sample) {
+    const T d = sample - this->window[this->pos];
+    this->window[this->pos] = sample;
+    this->pos = (this->pos + 1) % this->NFFT;
+
+    if (++this->count >= this->resync)
+        return this->_recompute();
+
+    T* re = this->re.data();
+    T* im = this->im.data();
+    const T* wr = this->wr.data();
+    const T* wi = this->wi.data();
+
+    for (int k = 0; k < this->NFFT / 2 + 1; k++) {
+        const T r = re[k] + d;
+        re[k] = r * wr[k] - im[k] * wi[k];
+        im[k] = r * wi[k] + im[k] * wr[k];
+    }
+};
+
+template<typename T>
+void
+spectrum::SlidingDFT<T>::values(cpx_t* freqdata) {
+    for (int k = 0; k < this->NFFT / 2 + 1; k++) {
+        freqdata[k].r = this->re[k];
+        freqdata[k].i = this->im[k];
+    }
+};
+
+template<typename T>
+void
+spectrum::SlidingDFT<T>::_recompute() {
+    std::copy(this->window.begin() + this->pos, this->window.end(), this->linear.begin());
+    std::copy(this->window.begin(), this->window.begin() + this->pos, 
+              this->linear.end() - this->pos);
+
+    BasicPlan<T>::getShared(this->NFFT, this->backend)->fftr(this->linear.data(), 
+                                                             this->freq.data());
+    for (int k = 0; k < this->NFFT / 2 + 1; k++) {
+        this->re[k] = this->freq[k].r;
+        this->im[k] = this->freq[k].i;
+    }
+    this->count = 0;
+};
+
+template class spectrum::SlidingDFT<float>;
+template class spectrum::SlidingDFT<double>;
@@ -0,0 +1,207 @@
+#include "Stockham.h"
+#include <cmath>
+#include <algorithm>
+
+spectrum::Stockham::Stockham(int NFFT)
+    : N(NFFT / 2)
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+    /* Splitting N into passes, powers of 4 first */
+    int n = this->N;
+    for (int p : {4, 2, 3, 5}) {
+        while (n % p == 0) {
+            this->radices.push_back(p);
+            n /= p;
+        }
+    }
+
+    /* Twiddles of the pass combining sub-transforms of size s
+     * into sub-transforms of size s * p: w = exp(-2 * pi * i / (s * p)) */
+    for (int i = 0, s = 1; i < (int)this->radices.size(); s *= this->radices[i++]) {
+        const int p = this->radices[i];
+        for (int r = 1; r < p; r++) {
+            for (int k = 0; k < s; k++) {
+                const double phase = -2 * pi * r * k / (s * p);
+                this->twiddles.push_back({(kiss_fft_scalar)std::cos(phase),
+                                          (kiss_fft_scalar)std::sin(phase)});
+            }
+        }
+    }
+
+    /* The same factors as kiss_fftr_alloc() */
+    for (int i = 0; i < this->N / 2; i++) {
+        const double phase = -pi * ((double)(i + 1) / this->N + .5);
+        this->superTwiddles.push_back({(kiss_fft_scalar)std::cos(phase),
+                                       (kiss_fft_scalar)std::sin(phase)});
+    }
+
+    this->work[0].resize(this->N);
+    this->work[1].resize(this->N);
+};
+
+spectrum::Stockham::~Stockham() {};
+
+bool
+spectrum::Stockham::isSupported(int NFFT) {
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        return false;
+
+    int n = NFFT / 2;
+    for (int p : {2, 3, 5}) {
+        while (n % p == 0)
+            n /= p;
+    }
+    return n == 1;
+};
+
+template<>
+void
+spectrum::Stockham::_butterfly<2>(kiss_fft_cpx* v) {
+    const kiss_fft_cpx a = v[0];
+    v[0].r = a.r + v[1].r; v[0].i = a.i + v[1].i;
+    v[1].r = a.r - v[1].r; v[1].i = a.i - v[1].i;
+};
+
+template<>
+void
+spectrum::Stockham::_butterfly<3>(kiss_fft_cpx* v) {
+    /* sin(2 * pi / 3) */
+    const kiss_fft_scalar s = 0.866025403784438646763723170752936183f;
+    const kiss_fft_cpx t = {v[1].r + v[2].r, v[1].i + v[2].i};
+    const kiss_fft_cpx d = {s * (v[1].r - v[2].r), s * (v[1].i - v[2].i)};
+    const kiss_fft_cpx h = {v[0].r - 0.5f * t.r, v[0].i - 0.5f * t.i};
+
+    v[0].r += t.r; v[0].i += t.i;
+    v[1].r = h.r + d.i; v[1].i = h.i - d.r;
+    v[2].r = h.r - d.i; v[2].i = h.i + d.r;
+};
+
+template<>
+void
+spectrum::Stockham::_butterfly<4>(kiss_fft_cpx* v) {
+    const kiss_fft_cpx s0 = {v[0].r + v[2].r, v[0].i + v[2].i};
+    const kiss_fft_cpx s1 = {v[0].r - v[2].r, v[0].i - v[2].i};
+    const kiss_fft_cpx s2 = {v[1].r + v[3].r, v[1].i + v[3].i};
+    const kiss_fft_cpx s3 = {v[1].r - v[3].r, v[1].i - v[3].i};
+
+    v[0].r = s0.r + s2.r; v[0].i = s0.i + s2.i;
+    v[2].r = s0.r - s2.r; v[2].i = s0.i - s2.i;
+    v[1].r = s1.r + s3.i; v[1].i = s1.i - s3.r;
+    v[3].r = s1.r - s3.i; v[3].i = s1.i + s3.r;
+};
+
+template<>
+void
+spectrum::Stockham::_butterfly<5>(kiss_fft_cpx* v) {
+    /* exp(-2 * pi * i / 5) and exp(-4 * pi * i / 5), as kf_bfly5() */
+    const kiss_fft_cpx ya = {0.309016994374947424102293417182819059f,
+                             -0.951056516295153572116439333379382143f};
+    const kiss_fft_cpx yb = {-0.809016994374947424102293417182819059f,
+                             -0.587785252292473129168705954639072769f};
+    const kiss_fft_cpx x0 = v[0];
+    const kiss_fft_cpx s7 = {v[1].r + v[4].r, v[1].i + v[4].i};
+    const kiss_fft_cpx s10 = {v[1].r - v[4].r, v[1].i - v[4].i};
+    const kiss_fft_cpx s8 = {v[2].r + v[3].r, v[2].i + v[3].i};
+    const kiss_fft_cpx s9 = {v[2].r - v[3].r, v[2].i - v[3].i};
+
+    const kiss_fft_cpx s5 = {x0.r + s7.r * ya.r + s8.r * yb.r,
+                             x0.i + s7.i * ya.r + s8.i * yb.r};
+    const kiss_fft_cpx s6 = {s10.i * ya.i + s9.i * yb.i,
+                             -s10.r * ya.i - s9.r * yb.i};
+    const kiss_fft_cpx s11 = {x0.r + s7.r * yb.r + s8.r * ya.r,
+                              x0.i + s7.i * yb.r + s8.i * ya.r};
+    const kiss_fft_cpx s12 = {-s10.i * yb.i + s9.i * ya.i,
+                              s10.r * yb.i - s9.r * ya.i};
+
+    v[0].r = x0.r + s7.r + s8.r; v[0].i = x0.i + s7.i + s8.i;
+    v[1].r = s5.r - s6.r; v[1].i = s5.i - s6.i;
+    v[4].r = s5.r + s6.r; v[4].i = s5.i + s6.i;
+    v[2].r = s11.r + s12.r; v[2].i = s11.i + s12.i;
+    v[3].r = s11.r - s12.r; v[3].i = s11.i - s12.i;
+};
+
+template<int P>
+void
+spectrum::Stockham::_pass(const int s, const kiss_fft_cpx* tw,
+                          const kiss_fft_cpx* x, kiss_fft_cpx* y) {
+    /* Input element j + r * m, j = b * s + k,
+     * goes to the output element b * s * P + r * s + k */
+    const int m = this->N / P;
+    kiss_fft_cpx v[P];
+
+    if (s == 1) {
+        /* The first pass has no twiddles, the loop runs over the blocks */
+        for (int b = 0; b < m; b++) {
+            for (int r = 0; r < P; r++)
+                v[r] = x[b + r * m];
+            _butterfly<P>(v);
+            for (int r = 0; r < P; r++)
+                y[b * P + r] = v[r];
+        }
+        return;
+    }
+
+    for (int b = 0; b < m / s; b++) {
+        const kiss_fft_cpx* src = x + b * s;
+        kiss_fft_cpx* dst = y + b * s * P;
+
+        for (int k = 0; k < s; k++) {
+            v[0] = src[k];
+            for (int r = 1; r < P; r++) {
+                const kiss_fft_cpx a = src[k + r * m];
+                const kiss_fft_cpx w = tw[(r - 1) * s + k];
+                v[r].r = a.r * w.r - a.i * w.i;
+                v[r].i = a.r * w.i + a.i * w.r;
+            }
+            _butterfly<P>(v);
+            for (int r = 0; r < P; r++)
+                dst[r * s + k] = v[r];
+        }
+    }
+};
+
+void
+spectrum::Stockham::fftr(const kiss_fft_scalar* timedata, kiss_fft_cpx* freqdata) {
+    /* The real signal is transformed as N complex values:
+     * even samples in the real parts, odd samples in the imaginary parts */
+    const kiss_fft_cpx* x = (const kiss_fft_cpx*)timedata;
+    const kiss_fft_cpx* tw = this->twiddles.data();
+    kiss_fft_cpx* y = this->work[0].data();
+
+    if (this->radices.empty())
+        std::copy(x, x + this->N, y);
+
+    for (int i = 0, s = 1; i < (int)this->radices.size(); s *= this->radices[i++]) {
+        y = this->work[i % 2].data();
+
+        switch (this->radices[i]) {
+            case 2: this->_pass<2>(s, tw, x, y); break;
+            case 3: this->_pass<3>(s, tw, x, y); break;
+            case 4: this->_pass<4>(s, tw, x, y); break;
+            case 5: this->_pass<5>(s, tw, x, y); break;
+        }
+        tw += (this->radices[i] - 1) * s;
+        x = y;
+    }
+
+    /* Splitting the spectra of the even and odd samples, as kiss_fftr() */
+    const int ncfft = this->N;
+    freqdata[0].r = y[0].r + y[0].i;
+    freqdata[ncfft].r = y[0].r - y[0].i;
+    freqdata[ncfft].i = freqdata[0].i = 0;
+
+    for (int k = 1; k <= ncfft / 2; k++) {
+        const kiss_fft_cpx fpk = y[k];
+        const kiss_fft_cpx fpnk = {y[ncfft - k].r, -y[ncfft - k].i};
+        const kiss_fft_cpx f1k = {fpk.r + fpnk.r, fpk.i + fpnk.i};
+        const kiss_fft_cpx f2k = {fpk.r - fpnk.r, fpk.i - fpnk.i};
+        const kiss_fft_cpx w = this->superTwiddles[k - 1];
+        const kiss_fft_cpx t = {f2k.r * w.r - f2k.i * w.i, f2k.r * w.i + f2k.i * w.r};
+
+        freqdata[k].r = 0.5f * (f1k.r + t.r);
+        freqdata[k].i = 0.5f * (f1k.i + t.i);
+        freqdata[ncfft - k].r = 0.5f * (f1k.r - t.r);
+        freqdata[ncfft - k].i = 0.5f * (t.i - f1k.i);
+    }
+};
@@ -0,0 +1,271 @@
+#include "Stream.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/* Times the analysis thread looks into the ring 
+ * during a hop of frames while it waits for one */
+#define STREAM_POLLS 4
+
+template<typename T>
+spectrum::BasicStream<T>::BasicStream(int NFFT, int hop, int sampleRate, int channels, 
+                                      callback_t callback, Backend backend, 
+                                      int bitDepth, int capacity, Overflow overflow)
+    : NFFT(NFFT),
+    hop(hop),
+    sampleRate(sampleRate),
+    channels(channels),
+    callback(callback),
+    overflow(overflow),
+    dynamicRange(spectrum::dynamicRange<T>(bitDepth)),
+    plan(NFFT > 0 ? NFFT : 2, backend),
+    ring((capacity > 0 ? capacity : std::max(sampleRate, 1)) * std::max(channels, 1)),
+    /* A mark refers to a frame at least, so every frame of the ring may have one */
+    marks(2 * (this->ring.getCapacity() / std::max(channels, 1) + 1)),
+    pushed(0),
+    dropped(0),
+    mark{0, 0},
+    coalesced(0),
+    received(0),
+    stopping(false)
+{
+    if (NFFT <= 0 || NFFT % 2 != 0)
+        spectrum::terminate(BAD_NFFT);
+
+    if (hop < 1 || hop > NFFT)
+        spectrum::terminate(BAD_HOP);
+
+    if (sampleRate <= 0)
+        spectrum::terminate(BAD_RATE);
+
+    if (channels < 1)
+        spectrum::terminate(BAD_CHANNELS);
+
+    if (!this->plan.isValid())
+        spectrum::terminate(BAD_ALLOCATE);
+
+    /* Everything the analysis needs is allocated before it starts */
+    this->block.resize(hop * channels);
+    this->windows.assign(channels, std::vector<T>(NFFT, 0));
+    
+    for (int i = 0; i < channels; i++) {
+        this->frames.push_back(frame_t(i, this->getFreqPerBin(), 0, 
+                                       std::vector<cpx_t>(NFFT / 2 + 1), 
+                                       std::vector<T>(NFFT / 2 + 1), 
+                                       0, 0, NFFT / 2 + 1));
+    }
+    
+    this->thread = std::thread(&BasicStream<T>::_run, this);
+};
+
+template<typename T>
+spectrum::BasicStream<T>::~BasicStream() {
+    this->stop();
+};
+
+template<typename T>
+int
+spectrum::BasicStream<T>::getNFFT() {
+    return this->NFFT;
+};
+
+template<typename T>
+int
+spectrum::BasicStream<T>::getHop() {
+    return this->hop;
+};
+
+template<typename T>
+int
+spectrum::BasicStream<T>::getSampleRate() {
+    return this->sampleRate;
+};
+
+template<typename T>
+int
+spectrum::BasicStream<T>::getChannels() {
+    return this->channels;
+};
+
+template<typename T>
+float
+spectrum::BasicStream<T>::getFreqPerBin() {
+    return (float)this->sampleRate / this->NFFT;
+};
+
+template<typename T>
+spectrum::Overflow
+spectrum::BasicStream<T>::getOverflow() {
+    return this->overflow;
+};
+
+template<typename T>
+void
+spectrum::BasicStream<T>::setFilter(const std::vector<T>& taps) {
+    if (taps.empty())
+        spectrum::terminate(BAD_TAPS);
+
+    /* The ring orders these writes before the frames of the next push(), 
+     * the analysis thread does not look at the filters before them */
+    this->filters.clear();
+    for (int i = 0; i < this->channels; i++) {
+        this->filters.emplace_back(new PartitionedFIR<T>(taps, this->hop, 
+                                                         this->plan.getBackend()));
+        if (!this->filters.back()->isValid())
+            spectrum::terminate(BAD_ALLOCATE);
+    }
+    this->unfiltered.resize(this->hop);
+};
+
+template<typename T>
+int
+spectrum::BasicStream<T>::push(const T* frames, int n) {
+    const long long now = _now();
+    int added = 0;
+    
+    while (true) {
+        /* Only whole frames are added, 
+         * the mark first so that the consumer finds it with the frames */
+        const int room = (this->ring.getCapacity() - this->ring.size()) / this->channels;
+        const int k = std::max(0, std::min(n - added, room));
+        const long long mark[2] = {this->pushed + k, now};
+        
+        if (k > 0 && this->marks.push(mark, 2) == 2) {
+            this->ring.push(frames + added * this->channels, k * this->channels);
+            this->pushed += k;
+            added += k;
+        }
+        
+        if (added == n || this->overflow != BLOCK)
+            break;
+        std::this_thread::sleep_for(this->_poll());
+    }
+    
+    if (added < n)
+        this->dropped.fetch_add(n - added, std::memory_order_relaxed);
+    return added;
+};
+
+template<typename T>
+long long
+spectrum::BasicStream<T>::getDropped() {
+    return this->dropped.load(std::memory_order_relaxed);
+};
+
+template<typename T>
+long long
+spectrum::BasicStream<T>::getCoalesced() {
+    return this->coalesced.load(std::memory_order_relaxed);
+};
+
+template<typename T>
+spectrum::Histogram&
+spectrum::BasicStream<T>::getLatency() {
+    return this->latency;
+};
+
+template<typename T>
+void
+spectrum::BasicStream<T>::stop() {
+    this->stopping.store(true, std::memory_order_release);
+    if (this->thread.joinable())
+        this->thread.join();
+};
+
+template<typename T>
+void
+spectrum::BasicStream<T>::_run() {
+    const int values = this->hop * this->channels;
+    
+    while (true) {
+        /* Read before the ring, so the frames pushed before stop() are seen */
+        const bool stopping = this->stopping.load(std::memory_order_acquire);
+        const int hops = this->ring.size() / values;
+        
+        if (hops == 0) {
+            if (stopping)
+                break;
+            std::this_thread::sleep_for(this->_poll());
+            continue;
+        }
+        
+        /* More than a window behind: the hops waiting only update the windows, 
+         * the spectrum of the newest one is emitted */
+        const bool coalesce = this->overflow == COALESCE && 
+                              (long long)hops * this->hop > this->NFFT;
+        
+        for (int i = coalesce ? 0 : hops - 1; i < hops; i++) {
+            this->ring.pop(this->block.data(), values);
+            this->_analyze(i == hops - 1);
+        }
+    }
+};
+
+template<typename T>
+void
+spectrum::BasicStream<T>::_analyze(bool emit) {
+    this->received += this->hop;
+    
+    for (int i = 0; i < this->channels; i++) {
+        std::vector<T>& window = this->windows[i];
+        
+        /* The oldest hop leaves the window, the new one is deinterleaved at its end */
+        std::copy(window.begin() + this->hop, window.end(), window.begin());
+        
+        T* last = window.data() + this->NFFT - this->hop;
+        T* hop = this->filters.empty() ? last : this->unfiltered.data();
+        for (int j = 0; j < this->hop; j++)
+            hop[j] = this->block[j * this->channels + i];
+        
+        if (!this->filters.empty())
+            this->filters[i]->process(hop, last);
+    }
+    
+    /* The mark of the push() of the last frame of the windows */
+    while (this->mark[0] < this->received && this->marks.pop(this->mark, 2) == 2);
+    
+    /* The first windows are emitted once NFFT frames are received */
+    if (this->received < this->NFFT)
+        return;
+    
+    if (!emit) {
+        this->coalesced.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    const long long first = this->received - this->NFFT;
+    
+    for (int i = 0; i < this->channels; i++) {
+        frame_t& frame = this->frames[i];
+        
+        frame.frame = (int)first;
+        frame.time = (float)((double)first / this->sampleRate);
+        
+        this->plan.fftr(this->windows[i].data(), frame.values.data());
+        
+        /* FFT normalization to db, as BasicProcessing::scale() */
+        for (int k = 0; k <= this->NFFT / 2; k++) {
+            frame.scaledValues[k] = spectrum::scaleValue(frame.values[k].r, frame.values[k].i, 
+                                                         this->dynamicRange);
+        }
+        this->latency.record(_now() - this->mark[1]);
+        this->callback(frame);
+    }
+};
+
+template<typename T>
+long long
+spectrum::BasicStream<T>::_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+};
+
+template<typename T>
+std::chrono::microseconds
+spectrum::BasicStream<T>::_poll() {
+    return std::chrono::microseconds(
+            std::max(1LL, 1000000LL * this->hop / this->sampleRate / STREAM_POLLS));
+};
+
+template class spectrum::BasicStream<float>;
+template class spectrum::BasicStream<double>;
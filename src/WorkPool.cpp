@@ -0,0 +1,118 @@
+#include "WorkPool.h"
+#include <algorithm>
+
+spectrum::WorkPool::WorkPool(int threads)
+    : next(0),
+    queued(0),
+    pending(0),
+    stop(false)
+{
+    if (threads < 1)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int w = 0; w < threads; w++)
+        this->queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    
+    for (int w = 0; w < threads; w++)
+        this->workers.push_back(std::thread(&WorkPool::_work, this, w));
+};
+
+spectrum::WorkPool::~WorkPool() {
+    this->wait();
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->available.notify_all();
+    
+    for (std::thread& w : this->workers)
+        w.join();
+};
+
+int
+spectrum::WorkPool::getThreads() {
+    return this->workers.size();
+};
+
+void
+spectrum::WorkPool::submit(std::function<void()> task) {
+    Queue& q = *this->queues[this->next++ % this->queues.size()];
+    
+    /* Counted before it is queued: a worker may take it and finish it 
+     * at once, wait() must not see the count of the tasks of other 
+     * threads drop to 0 meanwhile */
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queued++;
+        this->pending++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(std::move(task));
+    }
+    this->available.notify_one();
+};
+
+void
+spectrum::WorkPool::wait() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done.wait(lock, [this]() { return this->pending == 0; });
+};
+
+bool
+spectrum::WorkPool::_take(int w, std::function<void()>& task) {
+    const int W = this->queues.size();
+    
+    /* The newest task of the own queue, then the oldest one of the others */
+    for (int i = 0; i < W; i++) {
+        Queue& q = *this->queues[(w + i) % W];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        
+        if (q.tasks.empty())
+            continue;
+        
+        if (i == 0) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+};
+
+void
+spectrum::WorkPool::_work(int w) {
+    std::function<void()> task;
+    
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->available.wait(lock, [this]() { return this->queued > 0 || this->stop; });
+            
+            if (this->queued == 0 && this->stop)
+                return;
+        }
+        
+        /* Another worker may take the task first, 
+         * or the task counted is not queued yet */
+        if (!this->_take(w, task)) {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->queued--;
+        }
+        
+        task();
+        task = nullptr;
+        
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (--this->pending == 0)
+            this->done.notify_all();
+    }
+};
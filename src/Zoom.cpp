@@ -0,0 +1,180 @@
+#include "Zoom.h"
+#include <cmath>
+#include <algorithm>
+
+/* Filter taps per unit of decimation, Blackman window:
+ * the transition band is about 5.5 / (ZOOM_TAPS * D) of the sample rate,
+ * the stopband attenuation about 74 dB */
+#define ZOOM_TAPS 12
+
+/* Samples between exact computations of the mixing phasor */
+#define ZOOM_PHASOR_BLOCK 1024
+
+template<typename T>
+spectrum::Zoom<T>::Zoom(float fmin, float fmax, float resolution, int sampleRate)
+    : sampleRate(sampleRate),
+    centre((fmin + fmax) / 2.0),
+    cfg(nullptr),
+    cfg64(nullptr)
+{
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+    /* The decimated sample rate is at least twice the band width,
+     * the band and the transition of the filter fit in it */
+    this->D = std::max(1, (int)std::floor(sampleRate / (2.0 * (fmax - fmin))));
+    const double rate = (double)sampleRate / this->D;
+    this->M = kiss_fft_next_fast_size(std::max(1, (int)std::ceil(rate / resolution)));
+    
+    const double df = rate / this->M;
+    this->first = (int)std::ceil((fmin - this->centre) / df);
+    this->size = (int)std::floor((fmax - this->centre) / df) - this->first + 1;
+
+    /* Windowed sinc low-pass filter cut at the half of the decimated rate,
+     * normalized to a gain of 1 at 0 Hz */
+    if (this->D == 1)
+        this->taps.push_back(1);
+    else {
+        const int L = ZOOM_TAPS * this->D + 1;
+        const double fc = 0.5 / this->D;
+        double sum = 0;
+        std::vector<double> h(L);
+        
+        for (int l = 0; l < L; l++) {
+            const double t = l - (L - 1) / 2.0;
+            const double sinc = t == 0 ? 2 * fc : std::sin(2 * pi * fc * t) / (pi * t);
+            const double w = 0.42 - 0.5 * std::cos(2 * pi * l / (L - 1)) 
+                                  + 0.08 * std::cos(4 * pi * l / (L - 1));
+            h[l] = sinc * w;
+            sum += h[l];
+        }
+        for (int l = 0; l < L; l++)
+            this->taps.push_back((T)(h[l] / sum));
+    }
+
+    this->re.resize(this->M * this->D + this->taps.size() - 1);
+    this->im.resize(this->re.size());
+    this->decimated.resize(this->M);
+    this->freq.resize(this->M);
+    this->_alloc();
+};
+
+template<typename T>
+spectrum::Zoom<T>::~Zoom() {
+    if (this->cfg)
+        kiss_fft_free(this->cfg);
+    if (this->cfg64)
+        kiss_fft_free(this->cfg64);
+};
+
+template<>
+void
+spectrum::Zoom<float>::_alloc() {
+    this->cfg = kiss_fft_alloc(this->M, false, 0, 0);
+};
+
+template<>
+void
+spectrum::Zoom<double>::_alloc() {
+    this->cfg64 = kiss_fft_f64_alloc(this->M, false, 0, 0);
+};
+
+template<>
+void
+spectrum::Zoom<float>::_fft() {
+    kiss_fft(this->cfg, this->decimated.data(), this->freq.data());
+};
+
+template<>
+void
+spectrum::Zoom<double>::_fft() {
+    kiss_fft_f64(this->cfg64, this->decimated.data(), this->freq.data());
+};
+
+template<typename T>
+bool
+spectrum::Zoom<T>::isValid() {
+    return this->cfg || this->cfg64;
+};
+
+template<typename T>
+int
+spectrum::Zoom<T>::getInputSize() {
+    return this->M * this->D;
+};
+
+template<typename T>
+int
+spectrum::Zoom<T>::getSize() {
+    return this->size;
+};
+
+template<typename T>
+float
+spectrum::Zoom<T>::getFirstFreq() {
+    return this->centre + this->first * this->getFreqPerBin();
+};
+
+template<typename T>
+float
+spectrum::Zoom<T>::getFreqPerBin() {
+    return (double)this->sampleRate / this->getInputSize();
+};
+
+template<typename T>
+void
+spectrum::Zoom<T>::transform(const T* samples, const int N, cpx_t* values) {
+    const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+    const int L = this->taps.size();
+    const int half = (L - 1) / 2;
+    
+    /* Mixing down by exp(-2 * pi * i * centre * n / sampleRate),
+     * re[n + half] - frame n, the frames out of the signal are zero */
+    std::fill(this->re.begin(), this->re.end(), 0);
+    std::fill(this->im.begin(), this->im.end(), 0);
+    
+    const int n1 = std::min(N, (int)this->re.size() - half);
+    const double w = -2 * pi * this->centre / this->sampleRate;
+    const double cw = std::cos(w), sw = std::sin(w);
+    double cr = 1, ci = 0;
+    
+    for (int n = 0; n < n1; n++) {
+        if (n % ZOOM_PHASOR_BLOCK == 0) {
+            cr = std::cos(w * n);
+            ci = std::sin(w * n);
+        }
+        this->re[n + half] = (T)(samples[n] * cr);
+        this->im[n + half] = (T)(samples[n] * ci);
+        
+        const double r = cr * cw - ci * sw;
+        ci = cr * sw + ci * cw;
+        cr = r;
+    }
+    
+    /* Low-pass filter at the decimated frames only */
+    const T* h = this->taps.data();
+    for (int m = 0; m < this->M; m++) {
+        const T* xr = this->re.data() + m * this->D;
+        const T* xi = this->im.data() + m * this->D;
+        T yr = 0, yi = 0;
+        
+        for (int l = 0; l < L; l++) {
+            yr += h[l] * xr[l];
+            yi += h[l] * xi[l];
+        }
+        this->decimated[m].r = yr;
+        this->decimated[m].i = yi;
+    }
+    
+    this->_fft();
+    
+    /* Bins of the band, from -M / 2, scaled by D to the FFT 
+     * of the frames before the decimation */
+    for (int j = 0; j < this->size; j++) {
+        const cpx_t v = this->freq[(this->first + j + this->M) % this->M];
+        values[j].r = v.r * this->D;
+        values[j].i = v.i * this->D;
+    }
+};
+
+template class spectrum::Zoom<float>;
+template class spectrum::Zoom<double>;
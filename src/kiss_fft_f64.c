@@ -0,0 +1,24 @@
+/* kissfft compiled with double precision scalars 
+ * for spectrum::BasicPlan<double>
+ *
+ * Every public name gets the f64 suffix, so this build links 
+ * together with the float kissfft library 
+ * (the declarations are in Plan.h) */
+#define kiss_fft_scalar double
+
+#define kiss_fft_cpx kiss_fft_f64_cpx
+#define kiss_fft_state kiss_fft_f64_state
+#define kiss_fft_cfg kiss_fft_f64_cfg
+#define kiss_fft_alloc kiss_fft_f64_alloc
+#define kiss_fft kiss_fft_f64
+#define kiss_fft_stride kiss_fft_f64_stride
+#define kiss_fft_cleanup kiss_fft_f64_cleanup
+#define kiss_fft_next_fast_size kiss_fft_f64_next_fast_size
+#define kiss_fftr_state kiss_fftr_f64_state
+#define kiss_fftr_cfg kiss_fftr_f64_cfg
+#define kiss_fftr_alloc kiss_fftr_f64_alloc
+#define kiss_fftr kiss_fftr_f64
+#define kiss_fftri kiss_fftri_f64
+
+#include "kiss_fft.c"
+#include "kiss_fftr.c"
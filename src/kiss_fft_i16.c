@@ -0,0 +1,24 @@
+/* kissfft compiled with 16 bit fixed point scalars (FIXED_POINT=16)
+ * for spectrum::FixedPlan
+ *
+ * Every public name gets the i16 suffix, so this build links 
+ * together with the floating point kissfft library 
+ * (the declarations are in FixedPlan.h) */
+#define FIXED_POINT 16
+
+#define kiss_fft_cpx kiss_fft_i16_cpx
+#define kiss_fft_state kiss_fft_i16_state
+#define kiss_fft_cfg kiss_fft_i16_cfg
+#define kiss_fft_alloc kiss_fft_i16_alloc
+#define kiss_fft kiss_fft_i16
+#define kiss_fft_stride kiss_fft_i16_stride
+#define kiss_fft_cleanup kiss_fft_i16_cleanup
+#define kiss_fft_next_fast_size kiss_fft_i16_next_fast_size
+#define kiss_fftr_state kiss_fftr_i16_state
+#define kiss_fftr_cfg kiss_fftr_i16_cfg
+#define kiss_fftr_alloc kiss_fftr_i16_alloc
+#define kiss_fftr kiss_fftr_i16
+#define kiss_fftri kiss_fftri_i16
+
+#include "kiss_fft.c"
+#include "kiss_fftr.c"
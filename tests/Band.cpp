@@ -0,0 +1,67 @@
+#include "Check.h"
+#include "Processing.h"
+
+/* Calls of FFT() and pFFT() limited to different bands on the same object, 
+ * every entry keeps the bins of its own band */
+
+typedef spectrum::Processing::storage_t storage_t;
+
+/* The band entry holds the bins of the whole spectrum from its first frequency */
+static void compare(const storage_t::value_type& band, const storage_t::value_type& whole) {
+    const int beg = std::lround(band.firstFreq / band.freqPerBin);
+    
+    CHECK(band.channel == whole.channel);
+    CHECK(band.frame == whole.frame);
+    CHECK(band.bins > 0 && beg + band.bins <= whole.bins);
+    CHECK(band.values.size() == (size_t)band.bins);
+    CHECK(band.scaledValues.size() == (size_t)band.bins);
+    
+    for (int k = 0; k < band.bins && beg + k < whole.bins; k++) {
+        CHECK(band.values[k].r == whole.values[beg + k].r);
+        CHECK(band.values[k].i == whole.values[beg + k].i);
+        CHECK(band.scaledValues[k] == whole.scaledValues[beg + k]);
+    }
+}
+
+int main() {
+    const int NFFT = 512;
+    const std::string path = check::wav("band.wav", {check::noise(8000, 1), 
+                                                     check::noise(8000, 2)}, 8000);
+    spectrum::Processing p(NFFT, path.c_str());
+    
+    /* The narrow band first, then the whole spectrum */
+    p.FFT(0, 1000);
+    p.FFT();
+    p.FFT(2000, 3000);
+    
+    storage_t s = p.getfftValues();
+    CHECK(s.size() == 6);
+    if (s.size() == 6) {
+        for (int i = 0; i < 2; i++) {
+            CHECK(s[2 + i].bins == NFFT / 2 + 1);
+            CHECK(s[i].bins == 1000 / 8000.0 * NFFT + 1);
+            compare(s[i], s[2 + i]);
+            compare(s[4 + i], s[2 + i]);
+        }
+    }
+    
+    p.pFFT(4, 0, 1000);
+    p.pFFT(4);
+    
+    for (int channel = 0; channel < 2; channel++) {
+        s = p.getpfftValues(channel);
+        CHECK(s.size() == 8);
+        for (const auto& e : s)
+            CHECK(e.channel == channel);
+        
+        if (s.size() == 8) {
+            for (int j = 0; j < 4; j++) {
+                CHECK(s[4 + j].bins == NFFT / 2 + 1);
+                compare(s[j], s[4 + j]);
+            }
+        }
+    }
+    CHECK(p.getpfftValues().size() == 16);
+    
+    return check::result();
+}
@@ -0,0 +1,54 @@
+#include "Check.h"
+#include "Batch.h"
+#include <mutex>
+
+/* The batch analysis against the analysis of every file on its own, 
+ * and the bound of the plans kept by a thread */
+
+int main() {
+    const int NFFT = 512, timeScale = 8, files = 7;
+    std::vector<std::string> paths;
+    for (int i = 0; i < files; i++) {
+        paths.push_back(check::wav("batch" + std::to_string(i) + ".wav", 
+                                   {check::noise(4000 + 500 * i, i + 1)}, 8000));
+    }
+    paths.push_back("missing.wav");
+    
+    std::mutex mutex;
+    std::vector<int> calls(paths.size());
+    std::vector<spectrum::Processing::storage_t> spectra(paths.size());
+    std::vector<int> frames(paths.size(), -1);
+    
+    spectrum::Batch batch(NFFT, timeScale, spectrum::KISSFFT, 3);
+    batch.run(paths, [&](int index, const std::string& path, spectrum::Processing& p) {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls[index]++;
+        CHECK(path == paths[index]);
+        frames[index] = p.getFramesPerChannel();
+        if (p.getFramesPerChannel() > 0)
+            spectra[index] = p.getpfftValues();
+    });
+    
+    for (int i = 0; i < files; i++) {
+        CHECK(calls[i] == 1);
+        
+        spectrum::Processing p(NFFT, paths[i].c_str());
+        p.pFFT(timeScale);
+        const spectrum::Processing::storage_t reference = p.getpfftValues();
+        
+        CHECK(frames[i] == p.getFramesPerChannel());
+        CHECK(spectra[i].size() == reference.size());
+        for (size_t j = 0; j < std::min(spectra[i].size(), reference.size()); j++)
+            CHECK(spectra[i][j].scaledValues == reference[j].scaledValues);
+    }
+    CHECK(calls[files] == 1 && frames[files] == 0);
+    
+    /* The plans are reused, then dropped after enough other sizes */
+    std::weak_ptr<spectrum::Plan> first = spectrum::Plan::getShared(64);
+    CHECK(first.lock() == spectrum::Plan::getShared(64));
+    for (int NFFT = 128; NFFT <= 65536; NFFT *= 2)
+        CHECK(spectrum::Plan::getShared(NFFT)->isValid());
+    CHECK(first.expired());
+    
+    return check::result();
+}
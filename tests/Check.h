@@ -0,0 +1,113 @@
+#pragma once
+
+#include "AudioFile.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Helpers of the tests: every test is a program returning 0 
+ * when all of its checks pass (see tests/CMakeLists.txt) */
+namespace check {
+
+/* Number of checks failed so far */
+static int failures = 0;
+
+/* Reporting a failed condition, the test goes on */
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            check::failures++; \
+        } \
+    } while (0)
+
+/* Reporting a value larger than its bound */
+#define CHECK_BELOW(value, bound) \
+    do { \
+        const double v = (value), b = (bound); \
+        if (!(v < b)) { \
+            std::fprintf(stderr, "%s:%d: %s = %g, expected below %g\n", \
+                         __FILE__, __LINE__, #value, v, b); \
+            check::failures++; \
+        } \
+    } while (0)
+
+/* The exit status of the test */
+inline int result() {
+    if (failures)
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
+
+const double pi = 3.141592653589793238462643383279502884197169399375105820974944;
+
+/* The DFT of x computed by the definition, in double precision, 
+ * inverse - exp(+2 * pi * i * k * n / N) */
+inline std::vector<std::complex<double>> dft(const std::vector<std::complex<double>>& x, 
+                                             bool inverse = false) {
+    const int N = (int)x.size();
+    std::vector<std::complex<double>> w(N), X(N);
+    
+    for (int n = 0; n < N; n++)
+        w[n] = std::polar(1.0, (inverse ? 2 : -2) * pi * n / N);
+    
+    /* k * n modulo N, the phase of every term is exact */
+    for (int k = 0; k < N; k++) {
+        std::complex<double> sum = 0;
+        for (int n = 0, kn = 0; n < N; n++, kn = kn + k < N ? kn + k : kn + k - N)
+            sum += x[n] * w[kn];
+        X[k] = sum;
+    }
+    return X;
+}
+
+/* The DFT of a real signal, the NFFT / 2 + 1 values of a real FFT */
+inline std::vector<std::complex<double>> dftr(const std::vector<double>& x) {
+    std::vector<std::complex<double>> X = dft(
+            std::vector<std::complex<double>>(x.begin(), x.end()));
+    X.resize(x.size() / 2 + 1);
+    return X;
+}
+
+/* The largest error of X against the reference, 
+ * relative to the largest reference value */
+template<typename V>
+double error(const V& X, const std::vector<std::complex<double>>& reference) {
+    double err = 0, norm = 0;
+    for (size_t k = 0; k < reference.size(); k++) {
+        err = std::max(err, std::abs(std::complex<double>(X[k].r, X[k].i) - reference[k]));
+        norm = std::max(norm, std::abs(reference[k]));
+    }
+    return err / std::max(norm, 1e-300);
+}
+
+/* Uniform random values in [-1, 1), the same ones on every run */
+inline std::vector<double> noise(int N, unsigned seed = 1) {
+    std::vector<double> x(N);
+    for (int n = 0; n < N; n++) {
+        seed = seed * 1103515245u + 12345u;
+        x[n] = (double)((seed >> 8) & 0xFFFF) / 32768.0 - 1;
+    }
+    return x;
+}
+
+/* Writing the channels to a 16 bit WAV file, returns the path */
+inline std::string wav(const std::string& path, const std::vector<std::vector<double>>& channels, 
+                       int sampleRate, int bitDepth = 16) {
+    AudioFile<double> file;
+    file.setNumChannels((int)channels.size());
+    file.setNumSamplesPerChannel((int)channels[0].size());
+    file.setSampleRate(sampleRate);
+    file.setBitDepth(bitDepth);
+    
+    for (size_t i = 0; i < channels.size(); i++)
+        file.samples[i] = channels[i];
+    
+    file.save(path, AudioFileFormat::Wave);
+    return path;
+}
+}
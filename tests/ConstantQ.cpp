@@ -0,0 +1,51 @@
+#include "Check.h"
+#include "ConstantQ.h"
+
+/* The constant-Q transform by spectral kernels against the correlation 
+ * with the temporal kernels computed by the definition, they differ 
+ * by the dropped kernel values (CQ_THRESHOLD) and negative frequencies */
+
+static double error(int sampleRate, float fmin, float fmax, int binsPerOctave) {
+    spectrum::ConstantQ<double> cq(sampleRate, fmin, fmax, binsPerOctave);
+    CHECK(cq.isValid());
+    
+    const int NFFT = cq.getNFFT();
+    const int K = cq.getSize();
+    const double Q = 1 / (std::pow(2.0, 1.0 / binsPerOctave) - 1);
+    const std::vector<double> x = check::noise(NFFT);
+    
+    std::vector<kiss_fft_f64_cpx> values(K);
+    cq.transform(x.data(), values.data());
+    
+    /* Hamming windowed sinusoids of Q periods divided by their length, 
+     * centred in the FFT window */
+    std::vector<std::complex<double>> reference(K);
+    for (int k = 0; k < K; k++) {
+        const int N = (int)std::ceil(Q * sampleRate / cq.getFrequency(k));
+        for (int n = 0; n < N; n++) {
+            const double w = (0.54 - 0.46 * std::cos(2 * check::pi * n / N)) / N;
+            reference[k] += x[(NFFT - N) / 2 + n] 
+                          * std::polar(w, -2 * check::pi * Q * n / N);
+        }
+    }
+    return check::error(values, reference);
+}
+
+int main() {
+    /* More parameters than the cached kernels, then the first ones again */
+    for (int pass = 0; pass < 2; pass++) {
+        for (int binsPerOctave : {12, 24}) {
+            for (float fmin : {55.0f, 110.0f, 220.0f, 440.0f, 880.0f}) {
+                CHECK_BELOW(error(8000, fmin, 3500, binsPerOctave), 3e-2);
+            }
+        }
+    }
+    
+    /* The objects of the same parameters share the kernels */
+    spectrum::ConstantQ<float> a(8000, 110, 3500, 12), b(8000, 110, 3500, 12);
+    CHECK(a.getNFFT() == b.getNFFT() && a.getSize() == b.getSize());
+    CHECK(a.getSize() == (int)std::floor(12 * std::log2(3500 / 110.0)) + 1);
+    CHECK(std::abs(a.getFrequency(12) - 220) < 1e-3);
+    
+    return check::result();
+}
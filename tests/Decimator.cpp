@@ -0,0 +1,154 @@
+#include "Check.h"
+#include "Decimator.h"
+#include "Processing.h"
+#include "Simd.h"
+
+/* The polyphase decimation against the filter of every frame 
+ * followed by the downsampling, computed by the definition, 
+ * the rejection of the content above the new Nyquist frequency */
+
+/* The low-pass filter of the decimation (48 taps per unit of decimation, 
+ * Blackman window, see src/Decimator.cpp) */
+static std::vector<double> lowpass(int factor) {
+    if (factor == 1)
+        return {1};
+    
+    const int L = 48 * factor + 1;
+    const double fc = (0.5 - 2.75 / 48) / factor;
+    std::vector<double> h(L);
+    double sum = 0;
+    
+    for (int l = 0; l < L; l++) {
+        const double t = l - (L - 1) / 2.0;
+        const double sinc = t == 0 ? 2 * fc : std::sin(2 * check::pi * fc * t) / (check::pi * t);
+        h[l] = sinc * (0.42 - 0.5 * std::cos(2 * check::pi * l / (L - 1)) 
+                            + 0.08 * std::cos(4 * check::pi * l / (L - 1)));
+        sum += h[l];
+    }
+    for (double& v : h)
+        v /= sum;
+    return h;
+}
+
+/* The filter centred on every factor-th frame, the frames out of x are zero */
+static std::vector<double> reference(const std::vector<double>& x, int factor) {
+    const std::vector<double> h = lowpass(factor);
+    const int half = (h.size() - 1) / 2;
+    std::vector<double> y((x.size() + factor - 1) / factor);
+    
+    for (int n = 0; n < (int)y.size(); n++) {
+        for (int l = 0; l < (int)h.size(); l++) {
+            const int j = n * factor + l - half;
+            if (j >= 0 && j < (int)x.size())
+                y[n] += h[l] * x[j];
+        }
+    }
+    return y;
+}
+
+/* The largest amplitude of the outputs of a tone far from the ends of the signal */
+static double amplitude(spectrum::Decimator<double>& decimator, double f, int N) {
+    std::vector<double> x(N), y(decimator.getSize(N));
+    for (int n = 0; n < N; n++)
+        x[n] = std::cos(2 * check::pi * f * n);
+    
+    decimator.process(x.data(), N, y.data());
+    
+    const int edge = decimator.getLength() / decimator.getFactor();
+    double a = 0;
+    for (int n = edge; n < (int)y.size() - edge; n++)
+        a = std::max(a, std::abs(y[n]));
+    return a;
+}
+
+int main() {
+    /* The vectorized loops and their scalar remainder */
+    for (int K = 0; K < 20; K++) {
+        const std::vector<double> h = check::noise(K, 1), x = check::noise(K, 2);
+        const std::vector<float> hf(h.begin(), h.end()), xf(x.begin(), x.end());
+        std::vector<double> y = check::noise(K, 3), ry = y;
+        std::vector<float> yf(y.begin(), y.end());
+        
+        double dot = 0;
+        for (int k = 0; k < K; k++) {
+            dot += h[k] * x[k];
+            ry[k] += 0.5 * x[k];
+        }
+        CHECK_BELOW(std::abs(spectrum::simd::dot(h.data(), x.data(), K) - dot), 1e-12);
+        CHECK_BELOW(std::abs(spectrum::simd::dot(hf.data(), xf.data(), K) - dot), 1e-5);
+        
+        spectrum::simd::axpy(0.5, x.data(), y.data(), K);
+        spectrum::simd::axpy(0.5f, xf.data(), yf.data(), K);
+        for (int k = 0; k < K; k++) {
+            CHECK(y[k] == ry[k]);
+            CHECK_BELOW(std::abs(yf[k] - ry[k]), 1e-6);
+        }
+    }
+    
+    /* Polyphase against the filter of every frame, lengths not multiple 
+     * of the factor, shorter than the filter, longer than a block */
+    for (int factor : {1, 2, 3, 8}) {
+        spectrum::Decimator<double> decimator(factor);
+        CHECK(decimator.getFactor() == factor);
+        CHECK(decimator.getLength() == (int)lowpass(factor).size());
+        
+        for (int N : {1, 50, 1001, 3 * 1024 * factor + 7}) {
+            const std::vector<double> x = check::noise(N, N);
+            const std::vector<double> r = reference(x, factor);
+            std::vector<double> y(decimator.getSize(N));
+            CHECK(y.size() == r.size());
+            
+            decimator.process(x.data(), N, y.data());
+            double err = 0;
+            for (size_t n = 0; n < y.size() && n < r.size(); n++)
+                err = std::max(err, std::abs(y[n] - r[n]));
+            CHECK_BELOW(err, 1e-12);
+            
+            spectrum::Decimator<float> single(factor);
+            const std::vector<float> xf(x.begin(), x.end());
+            std::vector<float> yf(single.getSize(N));
+            single.process(xf.data(), N, yf.data());
+            for (size_t n = 0; n < yf.size() && n < r.size(); n++)
+                CHECK_BELOW(std::abs(yf[n] - r[n]), 1e-5);
+        }
+    }
+    
+    /* The passband up to 0.77 of the new Nyquist frequency is kept, 
+     * the stopband from the new Nyquist frequency is rejected by about 74 dB */
+    for (int factor : {2, 4, 6}) {
+        spectrum::Decimator<double> decimator(factor);
+        const double nyquist = 0.5 / factor;
+        
+        for (double f : {0.0, 0.25 * nyquist, 0.7 * nyquist})
+            CHECK_BELOW(std::abs(amplitude(decimator, f, 4000) - 1), 1e-3);
+        for (double f : {nyquist, 1.3 * nyquist, 0.5 * (nyquist + 0.5), 0.5})
+            CHECK_BELOW(amplitude(decimator, f, 4000), std::pow(10, -70 / 20.0));
+    }
+    
+    /* decimate(): the frames, the sample rate and the bins of the decimated domain */
+    const int rate = 48000, NFFT = 512, N = 10007;
+    const std::string path = check::wav("decimator.wav", {check::noise(N, 1), 
+                                                          check::noise(N, 2)}, rate);
+    for (int factor : {1, 3, 6}) {
+        spectrum::BasicProcessing<double> p(NFFT, path.c_str());
+        const std::vector<std::vector<double>> frames = p.getFrames();
+        p.decimate(factor);
+        
+        CHECK(p.getSampleRate() == rate / factor);
+        CHECK(std::abs(p.getFreqPerBin() - (float)(rate / factor) / NFFT) < 1e-6);
+        CHECK(p.getFramesPerChannel() == (N + factor - 1) / factor);
+        
+        const std::vector<std::vector<double>> decimated = p.getFrames();
+        for (int i = 0; i < 2; i++) {
+            const std::vector<double> r = reference(frames[i], factor);
+            CHECK(decimated[i].size() == r.size());
+            
+            double err = 0;
+            for (size_t n = 0; n < r.size() && n < decimated[i].size(); n++)
+                err = std::max(err, std::abs(decimated[i][n] - r[n]));
+            CHECK_BELOW(err, 1e-12);
+        }
+    }
+    
+    return check::result();
+}
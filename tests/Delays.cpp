@@ -0,0 +1,60 @@
+#include "Check.h"
+#include "CrossCorrelation.h"
+#include "Processing.h"
+
+/* Delays between channels: the second channel is the first one 
+ * delayed by a known number of frames */
+
+/* The delay of b after a in the window of NFFT frames */
+static double delay(const std::vector<double>& a, const std::vector<double>& b, 
+                    bool phat, int maxLag) {
+    const int NFFT = a.size();
+    spectrum::BasicPlan<double> plan(NFFT);
+    std::vector<kiss_fft_f64_cpx> A(NFFT / 2 + 1), B(NFFT / 2 + 1);
+    plan.fftr(a.data(), A.data());
+    plan.fftr(b.data(), B.data());
+    
+    spectrum::CrossCorrelation<double> correlation(NFFT, 2, phat, maxLag);
+    CHECK(correlation.isValid());
+    CHECK(correlation.getPairs() == 1);
+    
+    const kiss_fft_f64_cpx* spectra[] = {A.data(), B.data()};
+    double lag = 0;
+    correlation.delays(spectra, &lag);
+    return lag;
+}
+
+int main() {
+    const int NFFT = 256;
+    const std::vector<double> x = check::noise(3 * NFFT, 1);
+    
+    /* Delays beyond the half of the window are found by the linear 
+     * correlation, the circular one finds them at d - NFFT 
+     * (the windows still overlap by NFFT - |d| frames) */
+    for (int d : {-170, -150, -60, -1, 0, 1, 17, 100, 150, 170}) {
+        std::vector<double> a(NFFT), b(NFFT);
+        for (int n = 0; n < NFFT; n++) {
+            a[n] = x[NFFT + n];
+            b[n] = x[NFFT + n - d];
+        }
+        for (bool phat : {true, false})
+            CHECK_BELOW(std::abs(delay(a, b, phat, NFFT - 1) - d), 0.5);
+    }
+    
+    /* Processing::delays() from the spectra of pFFT() */
+    const int rate = 8000, d = 12;
+    std::vector<double> left = check::noise(rate, 2), right(rate);
+    for (int n = d; n < rate; n++)
+        right[n] = left[n - d];
+    
+    const std::string path = check::wav("delays.wav", {left, right}, rate);
+    spectrum::DoubleProcessing p(1024, path.c_str());
+    p.pFFT(4);
+    
+    const std::vector<double> delays = p.delays(true, 0.01f);
+    CHECK(delays.size() == 4);
+    for (double t : delays)
+        CHECK_BELOW(std::abs(t * rate - d), 0.5);
+    
+    return check::result();
+}
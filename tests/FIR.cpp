@@ -0,0 +1,95 @@
+#include "Check.h"
+#include "FastFIR.h"
+#include "PartitionedFIR.h"
+#include "Processing.h"
+
+/* The fast convolution filters against the convolution 
+ * computed by the definition, y[n] = sum of taps[k] * x[n - k] */
+
+static std::vector<double> convolve(const std::vector<double>& taps, const std::vector<double>& x) {
+    std::vector<double> y(x.size());
+    for (int n = 0; n < (int)x.size(); n++) {
+        for (int k = 0; k < (int)taps.size() && k <= n; k++)
+            y[n] += taps[k] * x[n - k];
+    }
+    return y;
+}
+
+/* The largest error relative to the largest output */
+static double error(const std::vector<double>& y, const std::vector<double>& reference) {
+    double err = 0, norm = 0;
+    for (size_t n = 0; n < reference.size(); n++) {
+        err = std::max(err, std::abs(y[n] - reference[n]));
+        norm = std::max(norm, std::abs(reference[n]));
+    }
+    return err / norm;
+}
+
+/* The signal in chunks of 1 to chunk frames */
+static double fast(const std::vector<double>& taps, int NFFT, const std::vector<double>& x, 
+                   int chunk, spectrum::Backend backend) {
+    spectrum::FastFIR<double> fir(taps, NFFT, backend);
+    CHECK(fir.isValid());
+    CHECK(fir.getBlockSize() == fir.getNFFT() - (int)taps.size() + 1);
+    
+    std::vector<double> y(x.size());
+    unsigned seed = 3;
+    for (size_t i = 0; i < x.size(); ) {
+        seed = seed * 1103515245u + 12345u;
+        const int N = std::min<int>(1 + (seed >> 8) % chunk, x.size() - i);
+        fir.process(x.data() + i, N, y.data() + i);
+        i += N;
+    }
+    return error(y, convolve(taps, x));
+}
+
+static double partitioned(const std::vector<double>& taps, int B, const std::vector<double>& x) {
+    spectrum::PartitionedFIR<double> fir(taps, B);
+    CHECK(fir.isValid());
+    CHECK(fir.getPartitions() == ((int)taps.size() + B - 1) / B);
+    
+    std::vector<double> y(x.size() / B * B);
+    for (size_t i = 0; i < y.size(); i += B)
+        fir.process(x.data() + i, y.data() + i);
+    
+    std::vector<double> reference = convolve(taps, x);
+    reference.resize(y.size());
+    return error(y, reference);
+}
+
+int main() {
+    const std::vector<double> x = check::noise(3000, 1);
+    
+    for (int L : {1, 2, 31, 256, 1000}) {
+        const std::vector<double> taps = check::noise(L, 2);
+        
+        for (int chunk : {3, 100, 5000}) {
+            CHECK_BELOW(fast(taps, 0, x, chunk, spectrum::KISSFFT), 1e-12);
+            CHECK_BELOW(fast(taps, 0, x, chunk, spectrum::STOCKHAM), 1e-12);
+        }
+        CHECK_BELOW(fast(taps, 2 * L + 30, x, 64, spectrum::KISSFFT), 1e-12);
+        
+        for (int B : {16, 64, 500})
+            CHECK_BELOW(partitioned(taps, B, x), 1e-12);
+    }
+    
+    /* The filters of a thread share its plans */
+    CHECK(spectrum::BasicPlan<double>::getShared(512) == spectrum::BasicPlan<double>::getShared(512));
+    CHECK(spectrum::FastFIR<double>::getCheapestSize(100) > 100);
+    
+    /* Processing::filter() with parts filtered by threads */
+    const std::vector<double> left = check::noise(20000, 4), right = check::noise(20000, 5);
+    const std::string path = check::wav("fir.wav", {left, right}, 8000, 24);
+    const std::vector<double> taps = check::noise(300, 6);
+    
+    for (int threads : {1, 3, 8}) {
+        spectrum::DoubleProcessing p(256, path.c_str());
+        const std::vector<std::vector<double>> frames = p.getFrames();
+        p.filter(taps, threads);
+        
+        for (int i = 0; i < 2; i++)
+            CHECK_BELOW(error(p.getFrames()[i], convolve(taps, frames[i])), 1e-12);
+    }
+    
+    return check::result();
+}
@@ -0,0 +1,69 @@
+#include "Check.h"
+#include "FixedPlan.h"
+#include "FixedProcessing.h"
+
+/* The fixed point engines against the DFT computed by the definition, 
+ * their spectrum is the one of the DFT divided by NFFT */
+
+template<typename T>
+static double error(int NFFT) {
+    const double amplitude = std::ldexp(1.0, 8 * sizeof(T) - 2);
+    const std::vector<double> x = check::noise(NFFT);
+    
+    std::vector<T> in(NFFT);
+    std::vector<double> quantized(NFFT);
+    for (int n = 0; n < NFFT; n++) {
+        in[n] = (T)std::lround(x[n] * amplitude);
+        quantized[n] = (double)in[n] / NFFT;
+    }
+    
+    std::vector<typename spectrum::FixedPlan<T>::cpx_t> out(NFFT / 2 + 1);
+    spectrum::FixedPlan<T> plan(NFFT);
+    CHECK(plan.isValid());
+    plan.fftr(in.data(), out.data());
+    
+    return check::error(out, check::dftr(quantized));
+}
+
+/* Every entry is a whole spectrum of its own channel */
+template<typename T>
+static void processing(const std::string& path, int NFFT) {
+    spectrum::FixedProcessing<T> p(NFFT, path.c_str());
+    
+    p.FFT();
+    typename spectrum::FixedProcessing<T>::storage_t s = p.getfftValues();
+    CHECK(s.size() == 2);
+    for (size_t i = 0; i < s.size(); i++) {
+        CHECK(s[i].channel == (int)i);
+        CHECK(s[i].bins == NFFT / 2 + 1);
+        CHECK(s[i].values.size() == (size_t)(NFFT / 2 + 1));
+        CHECK(s[i].scaledValues.size() == (size_t)(NFFT / 2 + 1));
+    }
+    
+    /* The first window of the channel is the one of FFT */
+    p.pFFT(10);
+    for (int channel = 0; channel < 2; channel++) {
+        s = p.getpfftValues(channel);
+        CHECK(s.size() == (size_t)std::ceil(p.getFileDuration() * 10));
+        
+        for (size_t i = 0; i < s.size(); i++) {
+            CHECK(s[i].channel == channel);
+            CHECK(s[i].values.size() == (size_t)(NFFT / 2 + 1));
+        }
+        CHECK(s[0].scaledValues == p.getfftValues()[channel].scaledValues);
+    }
+    CHECK(p.getpfftValues().size() == 2 * s.size());
+}
+
+int main() {
+    for (int NFFT : {8, 64, 256, 1024, 4096}) {
+        CHECK_BELOW(error<int16_t>(NFFT), 2e-2);
+        CHECK_BELOW(error<int32_t>(NFFT), 1e-6);
+    }
+    
+    const std::vector<double> left = check::noise(4000, 1), right = check::noise(4000, 2);
+    processing<int16_t>(check::wav("fixed16.wav", {left, right}, 8000, 16), 256);
+    processing<int32_t>(check::wav("fixed24.wav", {left, right}, 8000, 24), 256);
+    
+    return check::result();
+}
@@ -0,0 +1,78 @@
+#include "Check.h"
+#include "kiss_fft.h"
+
+/* The four-step kissfft of sizes above KISS_FFT_FOURSTEP_THRESHOLD, 
+ * too large for the whole reference DFT: a few bins are computed 
+ * by the definition, then the whole spectrum is transformed back */
+
+static void fourStep(int N) {
+    const std::vector<double> re = check::noise(N, 3), im = check::noise(N, 4);
+    std::vector<kiss_fft_cpx> in(N), out(N), back(N);
+    
+    for (int n = 0; n < N; n++) {
+        in[n].r = (float)re[n];
+        in[n].i = (float)im[n];
+    }
+    
+    kiss_fft_cfg cfg = kiss_fft_alloc(N, false, 0, 0);
+    kiss_fft_cfg icfg = kiss_fft_alloc(N, true, 0, 0);
+    CHECK(cfg != nullptr && icfg != nullptr);
+    if (!cfg || !icfg)
+        return;
+    
+    kiss_fft(cfg, in.data(), out.data());
+    kiss_fft(icfg, out.data(), back.data());
+    kiss_fft_free(cfg);
+    kiss_fft_free(icfg);
+    
+    /* The RMS error of the bins relative to the RMS of the spectrum, 
+     * sqrt(N) times the RMS of the signal */
+    double err = 0, power = 0;
+    for (int n = 0; n < N; n++)
+        power += (double)in[n].r * in[n].r + (double)in[n].i * in[n].i;
+    
+    const int bins = 32;
+    for (int b = 0; b < bins; b++) {
+        /* Bins of every part of the spectrum, the first and the last ones */
+        const int k = b < 2 ? b * (N - 1) : (int)((long long)b * 7919 * 104729 % N);
+        
+        /* exp(-2 * pi * i * k * n / N) by a rotation, recomputed 
+         * from the exact phase of k * n modulo N every 256 samples */
+        const double sr = std::cos(2 * check::pi * k / N), si = -std::sin(2 * check::pi * k / N);
+        double sumr = 0, sumi = 0, wr = 1, wi = 0;
+        
+        for (int n = 0; n < N; n++) {
+            if (n % 256 == 0) {
+                const double phase = -2 * check::pi * (double)((long long)k * n % N) / N;
+                wr = std::cos(phase);
+                wi = std::sin(phase);
+            }
+            sumr += in[n].r * wr - in[n].i * wi;
+            sumi += in[n].r * wi + in[n].i * wr;
+            
+            const double t = wr * sr - wi * si;
+            wi = wr * si + wi * sr;
+            wr = t;
+        }
+        const std::complex<double> X(sumr, sumi);
+        
+        err += std::norm(std::complex<double>(out[k].r, out[k].i) - X);
+    }
+    err = std::sqrt(err / bins);
+    
+    /* The level of the mixed radix path at these sizes (about 8e-7) */
+    CHECK_BELOW(err / std::sqrt(power), 1e-6);
+    
+    double roundTrip = 0;
+    for (int n = 0; n < N; n++) {
+        roundTrip = std::max(roundTrip, (double)std::abs(back[n].r / N - in[n].r));
+        roundTrip = std::max(roundTrip, (double)std::abs(back[n].i / N - in[n].i));
+    }
+    CHECK_BELOW(roundTrip, 1e-5);
+}
+
+int main() {
+    fourStep(1 << 21);
+    fourStep(3 << 20);
+    return check::result();
+}
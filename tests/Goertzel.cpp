@@ -0,0 +1,75 @@
+#include "Check.h"
+#include "Goertzel.h"
+#include "Processing.h"
+
+/* The Goertzel magnitudes against the DTFT of the samples computed 
+ * by the definition: the FFT bins for bin-centred frequencies */
+
+/* |sum of x[n] * exp(-2 * pi * i * f * n / sampleRate)| of the first N samples */
+static double dtft(const double* x, int N, double f, int sampleRate) {
+    std::complex<double> sum = 0;
+    for (int n = 0; n < N; n++)
+        sum += x[n] * std::polar(1.0, -2 * check::pi * std::fmod(f * n, sampleRate) / sampleRate);
+    return std::abs(sum);
+}
+
+int main() {
+    const int N = 500, rate = 8000;
+    const std::vector<double> x = check::noise(N, 1);
+    const std::vector<std::complex<double>> X = check::dftr(x);
+    
+    /* Bin centres k * rate / N, the first and the last bins, 
+     * then frequencies between the bins */
+    const std::vector<int> bins = {0, 1, 37, 123, 250};
+    std::vector<float> frequencies;
+    for (int k : bins)
+        frequencies.push_back((float)k * rate / N);
+    frequencies.push_back(1234.5f);
+    frequencies.push_back(3999.0f);
+    
+    spectrum::Goertzel<double> goertzel(frequencies, rate);
+    CHECK(goertzel.getSize() == (int)frequencies.size());
+    
+    std::vector<double> magnitudes(frequencies.size());
+    goertzel.magnitudes(x.data(), N, magnitudes.data());
+    
+    double norm = 0;
+    for (const std::complex<double>& v : X)
+        norm = std::max(norm, std::abs(v));
+    
+    for (size_t k = 0; k < bins.size(); k++)
+        CHECK_BELOW(std::abs(magnitudes[k] - std::abs(X[bins[k]])) / norm, 1e-9);
+    for (size_t k = 0; k < frequencies.size(); k++)
+        CHECK_BELOW(std::abs(magnitudes[k] - dtft(x.data(), N, frequencies[k], rate)) / norm, 1e-9);
+    
+    /* The state is cleared by every call */
+    goertzel.magnitudes(x.data(), N, magnitudes.data());
+    CHECK_BELOW(std::abs(magnitudes[2] - std::abs(X[37])) / norm, 1e-9);
+    
+    /* detect(): the NFFT frames of every time point of pFFT(timeScale), 
+     * the last ones zero padded */
+    const int NFFT = 512, timeScale = 10;
+    const std::string path = check::wav("goertzel.wav", {check::noise(rate + 300, 2), 
+                                                         check::noise(rate + 300, 3)}, rate);
+    spectrum::BasicProcessing<double> p(NFFT, path.c_str());
+    const std::vector<std::vector<double>> frames = p.getFrames();
+    
+    const std::vector<float> targets = {(float)rate / NFFT * 10, 440.0f, 3000.0f};
+    const std::vector<double> detected = p.detect(targets, timeScale, 1);
+    
+    const int K = targets.size(), segment = rate / timeScale;
+    const int points = std::ceil(p.getFileDuration() * timeScale);
+    CHECK(detected.size() == (size_t)(points * K));
+    
+    double err = 0;
+    for (int j = 0; j < points && (size_t)((j + 1) * K) <= detected.size(); j++) {
+        const int n = std::max(0, std::min(NFFT, (int)frames[1].size() - j * segment));
+        for (int k = 0; k < K; k++) {
+            const double reference = dtft(frames[1].data() + j * segment, n, targets[k], rate);
+            err = std::max(err, std::abs(detected[j * K + k] - reference) / NFFT);
+        }
+    }
+    CHECK_BELOW(err, 1e-9);
+    
+    return check::result();
+}
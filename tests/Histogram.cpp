@@ -0,0 +1,55 @@
+#include "Check.h"
+#include "Histogram.h"
+#include <algorithm>
+#include <thread>
+
+/* The log-linear histogram: exact below 64, the percentiles 
+ * within 3% of the values recorded above */
+
+int main() {
+    spectrum::Histogram histogram;
+    CHECK(histogram.getCount() == 0 && histogram.getMax() == 0);
+    CHECK(histogram.getPercentile(50) == 0);
+    
+    /* Values below 64 have a bucket each, negative values are counted as 0 */
+    for (long long v = 0; v < 64; v++)
+        histogram.record(v);
+    histogram.record(-5);
+    CHECK(histogram.getCount() == 65 && histogram.getMax() == 63);
+    CHECK(histogram.getPercentile(0) == 0);
+    CHECK(histogram.getPercentile(50) == 31);
+    CHECK(histogram.getPercentile(100) == 63);
+    
+    /* Values over the whole range, from two threads, against their exact percentiles */
+    histogram.reset();
+    CHECK(histogram.getCount() == 0 && histogram.getMax() == 0);
+    
+    std::vector<long long> values(20000);
+    unsigned long long seed = 7;
+    for (long long& v : values) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        v = 1 + (long long)(seed >> (16 + (seed >> 59)));
+    }
+    
+    std::thread other([&]() {
+        for (size_t i = 0; i < values.size(); i += 2)
+            histogram.record(values[i]);
+    });
+    for (size_t i = 1; i < values.size(); i += 2)
+        histogram.record(values[i]);
+    other.join();
+    
+    std::sort(values.begin(), values.end());
+    CHECK(histogram.getCount() == (long long)values.size());
+    CHECK(histogram.getMax() == values.back());
+    
+    for (double p : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+        const long long exact = values[(size_t)std::ceil(p / 100 * values.size()) - 1];
+        const long long value = histogram.getPercentile(p);
+        CHECK(value >= exact);
+        CHECK_BELOW((double)(value - exact) / exact, 0.03);
+    }
+    CHECK(histogram.getPercentile(100) == values.back());
+    
+    return check::result();
+}
@@ -0,0 +1,102 @@
+#include "Check.h"
+#include "Processing.h"
+
+/* The inverse STFT of the spectra of pFFT() and sFFT() gives back 
+ * the frames of the audio file, the spectra of a band give back 
+ * the frames of the band, by one thread or several */
+
+typedef spectrum::BasicProcessing<double> Processing;
+
+/* The largest difference of the frames of the channels */
+static double error(const std::vector<std::vector<double>>& a, 
+                    const std::vector<std::vector<double>>& b) {
+    CHECK(a.size() == b.size());
+    double err = 0;
+    for (size_t i = 0; i < a.size() && i < b.size(); i++) {
+        CHECK(a[i].size() == b[i].size());
+        for (size_t n = 0; n < a[i].size() && n < b[i].size(); n++)
+            err = std::max(err, std::abs(a[i][n] - b[i][n]));
+    }
+    return err;
+}
+
+int main() {
+    const int rate = 8000, N = rate + 123;
+    const std::string path = check::wav("istft.wav", {check::noise(N, 1), 
+                                                      check::noise(N, 2)}, rate);
+    
+    /* Windows of NFFT frames every sampleRate / timeScale frames: 
+     * 1/4, 1/2 and about all of the window apart */
+    for (auto config : std::vector<std::pair<int, int>>{{256, 125}, {256, 62}, {256, 32}, 
+                                                        {512, 50}, {512, 20}}) {
+        const int NFFT = config.first, timeScale = config.second;
+        
+        for (int threads : {1, 4}) {
+            /* The whole band */
+            Processing p(NFFT, path.c_str());
+            const std::vector<std::vector<double>> frames = p.getFrames();
+            p.pFFT(timeScale);
+            p.ISTFT(p.getpfftValues(), threads);
+            CHECK_BELOW(error(p.getFrames(), frames), 1e-12);
+            
+            /* A band: the frames of the whole spectra without the other bins */
+            const float fmin = 1000, fmax = 2500;
+            Processing band(NFFT, path.c_str()), whole(NFFT, path.c_str());
+            band.pFFT(timeScale, fmin, fmax);
+            whole.pFFT(timeScale);
+            
+            Processing::storage_t spectra = whole.getpfftValues();
+            const Processing::storage_t limited = band.getpfftValues();
+            CHECK(limited.size() == spectra.size() && limited[0].bins < NFFT / 2 + 1);
+            
+            const int beg = std::lround(limited[0].firstFreq / limited[0].freqPerBin);
+            for (auto& s : spectra) {
+                for (int k = 0; k < s.bins; k++) {
+                    if (k < beg || k >= beg + limited[0].bins)
+                        s.values[k] = kiss_fft_f64_cpx{0, 0};
+                }
+            }
+            
+            band.ISTFT(limited, threads);
+            whole.ISTFT(spectra, 1);
+            CHECK_BELOW(error(band.getFrames(), whole.getFrames()), 1e-12);
+            CHECK(error(band.getFrames(), frames) > 0.1);
+        }
+    }
+    
+    /* The threads give the same frames as one thread */
+    Processing a(256, path.c_str()), b(256, path.c_str());
+    a.pFFT(100);
+    b.pFFT(100);
+    a.ISTFT(a.getpfftValues(), 1);
+    b.ISTFT(b.getpfftValues(), 3);
+    CHECK(a.getFrames() == b.getFrames());
+    
+    /* The spectra of sFFT(), those of one channel only: 
+     * the other channel is left as it is */
+    Processing s(128, path.c_str());
+    const std::vector<std::vector<double>> frames = s.getFrames();
+    s.sFFT(40);
+    s.ISTFT(s.getsfftValues(1), 2);
+    
+    const std::vector<std::vector<double>> resynthesized = s.getFrames();
+    CHECK(resynthesized[0] == frames[0]);
+    
+    /* The last frames after the last window of the hop are not covered */
+    const int covered = (N - 128) / 40 * 40 + 128;
+    CHECK_BELOW(error({std::vector<double>(resynthesized[1].begin(), 
+                                           resynthesized[1].begin() + covered)}, 
+                      {std::vector<double>(frames[1].begin(), frames[1].begin() + covered)}), 1e-12);
+    for (int n = covered; n < N; n++)
+        CHECK(resynthesized[1][n] == 0);
+    
+    /* save(): the frames written with the sample rate and the bit depth, 
+     * up to a step of the 16 bit quantization */
+    CHECK(a.save("istft.out.wav"));
+    Processing saved(256, "istft.out.wav");
+    CHECK(saved.getSampleRate() == rate && saved.getBitDepth() == 16);
+    CHECK(saved.getChannels() == 2 && saved.getFramesPerChannel() == N);
+    CHECK_BELOW(error(saved.getFrames(), a.getFrames()), 1.5 / 32768);
+    
+    return check::result();
+}
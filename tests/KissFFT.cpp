@@ -0,0 +1,70 @@
+#include "Check.h"
+#include "kiss_fft.h"
+#include "kiss_fftr.h"
+
+/* kissfft against the DFT computed by the definition */
+
+static double complexError(int N, bool inverse) {
+    const std::vector<double> re = check::noise(N, 1), im = check::noise(N, 2);
+    std::vector<std::complex<double>> x(N);
+    std::vector<kiss_fft_cpx> in(N), out(N);
+    
+    for (int n = 0; n < N; n++) {
+        x[n] = std::complex<double>(re[n], im[n]);
+        in[n].r = (float)re[n];
+        in[n].i = (float)im[n];
+    }
+    
+    kiss_fft_cfg cfg = kiss_fft_alloc(N, inverse, 0, 0);
+    kiss_fft(cfg, in.data(), out.data());
+    kiss_fft_free(cfg);
+    
+    return check::error(out, check::dft(x, inverse));
+}
+
+static double realError(int N) {
+    const std::vector<double> x = check::noise(N);
+    std::vector<float> in(x.begin(), x.end());
+    std::vector<kiss_fft_cpx> out(N / 2 + 1);
+    
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(N, false, 0, 0);
+    kiss_fftr(cfg, in.data(), out.data());
+    kiss_fft_free(cfg);
+    
+    return check::error(out, check::dftr(x));
+}
+
+int main() {
+    /* Radix-8 stages with up to two radix-4 ones (powers of 2), 
+     * then mixed sizes whose power of 2 part goes through them too */
+    for (int N : {2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 
+                  24, 40, 96, 1000, 3 * 512, 5 * 1024}) {
+        CHECK_BELOW(complexError(N, false), 1e-6);
+        CHECK_BELOW(complexError(N, true), 1e-6);
+    }
+    
+    for (int N : {16, 64, 512, 4096, 1000, 8192})
+        CHECK_BELOW(realError(N), 1e-6);
+    
+    /* The SSE butterflies take two groups at a time, odd numbers of groups 
+     * end with the scalar code, as the pairs of bins of kiss_fftr 
+     * (the same checks run on the scalar build, see tests/CMakeLists.txt) */
+    for (int N : {8 * 3, 8 * 5, 8 * 7, 4 * 9, 4 * 3, 2 * 15, 8 * 8 * 3}) {
+        CHECK_BELOW(complexError(N, false), 1e-6);
+        CHECK_BELOW(complexError(N, true), 1e-6);
+    }
+    
+    for (int N : {4, 12, 20, 28, 44, 1030, 2 * 3 * 5 * 7})
+        CHECK_BELOW(realError(N), 1e-6);
+    
+    /* Bluestein's algorithm: a prime factor above 100 */
+    for (int N : {101, 211, 2 * 509, 1009, 4 * 1013, 7919}) {
+        CHECK_BELOW(complexError(N, false), 1e-6);
+        CHECK_BELOW(complexError(N, true), 1e-6);
+    }
+    
+    for (int N : {2 * 101, 2 * 1009, 4 * 1013})
+        CHECK_BELOW(realError(N), 1e-6);
+    
+    return check::result();
+}
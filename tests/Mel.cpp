@@ -0,0 +1,124 @@
+#include "Check.h"
+#include "Mel.h"
+#include "Processing.h"
+
+/* The sparse mel filterbank and the MFCC against a dense matrix 
+ * of the triangular filters followed by the orthonormal DCT-II, 
+ * both computed by the definition */
+
+/* The log energies and the MFCC of the spectrum X */
+struct Reference {
+    std::vector<double> energies;
+    std::vector<double> mfcc;
+    
+    Reference(const std::vector<std::complex<double>>& X, int NFFT, int sampleRate, 
+              int filters, int coefficients, double fmin, double fmax) {
+        auto mel = [](double f) { return 2595 * std::log10(1 + f / 700); };
+        auto hz = [](double m) { return 700 * (std::pow(10, m / 2595) - 1); };
+        
+        /* [m][j] - the weight of the j-th bin in the m-th filter */
+        std::vector<std::vector<double>> matrix(filters, std::vector<double>(NFFT / 2 + 1));
+        for (int m = 0; m < filters; m++) {
+            const double lo = hz(mel(fmin) + (mel(fmax) - mel(fmin)) * m / (filters + 1));
+            const double mid = hz(mel(fmin) + (mel(fmax) - mel(fmin)) * (m + 1) / (filters + 1));
+            const double hi = hz(mel(fmin) + (mel(fmax) - mel(fmin)) * (m + 2) / (filters + 1));
+            
+            for (int j = 0; j <= NFFT / 2; j++) {
+                const double f = (double)j * sampleRate / NFFT;
+                matrix[m][j] = std::max(0.0, std::min((f - lo) / (mid - lo), (hi - f) / (hi - mid)));
+            }
+        }
+        
+        for (int m = 0; m < filters; m++) {
+            double e = 0;
+            for (int j = 0; j <= NFFT / 2; j++)
+                e += matrix[m][j] * std::norm(X[j]);
+            this->energies.push_back(std::log(std::max(e, 1e-10)));
+        }
+        
+        for (int c = 0; c < coefficients; c++) {
+            double s = 0;
+            for (int m = 0; m < filters; m++)
+                s += this->energies[m] * std::cos(check::pi * c * (m + 0.5) / filters);
+            this->mfcc.push_back(s * std::sqrt((c == 0 ? 1.0 : 2.0) / filters));
+        }
+    }
+};
+
+/* The largest difference of the values */
+static double error(const double* values, const std::vector<double>& reference) {
+    double err = 0;
+    for (size_t k = 0; k < reference.size(); k++)
+        err = std::max(err, std::abs(values[k] - reference[k]));
+    return err;
+}
+
+int main() {
+    const int NFFT = 512, rate = 16000;
+    const std::vector<double> x = check::noise(NFFT, 1);
+    const std::vector<std::complex<double>> X = check::dftr(x);
+    
+    std::vector<kiss_fft_f64_cpx> spectrum(X.size());
+    for (size_t k = 0; k < X.size(); k++) {
+        spectrum[k].r = X[k].real();
+        spectrum[k].i = X[k].imag();
+    }
+    
+    /* Narrow filters of a bin or less at the low frequencies, 
+     * a band from 0 Hz, a band up to the Nyquist frequency */
+    for (auto band : std::vector<std::pair<double, double>>{{0, 8000}, {300, 3400}, {20, 2000}}) {
+        for (int filters : {10, 26, 40}) {
+            const int coefficients = 13 < filters ? 13 : filters;
+            spectrum::Mel<double> bank(NFFT, rate, filters, coefficients, band.first, band.second);
+            CHECK(bank.getFilters() == filters && bank.getCoefficients() == coefficients);
+            
+            const Reference reference(X, NFFT, rate, filters, coefficients, 
+                                      band.first, band.second);
+            std::vector<double> energies(filters), mfcc(coefficients);
+            bank.energies(spectrum.data(), energies.data());
+            bank.mfcc(spectrum.data(), mfcc.data());
+            
+            CHECK_BELOW(error(energies.data(), reference.energies), 1e-9);
+            CHECK_BELOW(error(mfcc.data(), reference.mfcc), 1e-9);
+        }
+    }
+    
+    /* A silent spectrum: the energies are limited before the log */
+    std::vector<kiss_fft_f64_cpx> silence(NFFT / 2 + 1, kiss_fft_f64_cpx{0, 0});
+    spectrum::Mel<double> bank(NFFT, rate, 20, 13, 0, 8000);
+    std::vector<double> energies(20);
+    bank.energies(silence.data(), energies.data());
+    CHECK_BELOW(error(energies.data(), std::vector<double>(20, std::log(1e-10))), 1e-9);
+    
+    /* mel() and mfcc(): the NFFT frames of every time point of pFFT(timeScale), 
+     * the last ones zero padded */
+    const int timeScale = 10, filters = 26, coefficients = 13;
+    const std::string path = check::wav("mel.wav", {check::noise(rate + 300, 2), 
+                                                    check::noise(rate + 300, 3)}, rate);
+    spectrum::BasicProcessing<double> p(NFFT, path.c_str());
+    const std::vector<std::vector<double>> frames = p.getFrames();
+    const std::vector<double> mel = p.mel(filters, 100, 7000, timeScale, 1);
+    const std::vector<double> mfcc = p.mfcc(filters, coefficients, 100, 7000, timeScale, 1);
+    
+    const int segment = rate / timeScale;
+    const int points = std::ceil(p.getFileDuration() * timeScale);
+    CHECK(mel.size() == (size_t)(points * filters));
+    CHECK(mfcc.size() == (size_t)(points * coefficients));
+    
+    double err = 0;
+    for (int j = 0; j < points && (size_t)((j + 1) * filters) <= mel.size() 
+                    && (size_t)((j + 1) * coefficients) <= mfcc.size(); j++) {
+        const int n = std::max(0, std::min(NFFT, (int)frames[1].size() - j * segment));
+        std::vector<double> window(frames[1].begin() + j * segment, 
+                                   frames[1].begin() + j * segment + n);
+        window.resize(NFFT);
+        
+        const Reference reference(check::dftr(window), NFFT, rate, filters, coefficients, 
+                                  100, 7000);
+        err = std::max(err, error(mel.data() + j * filters, reference.energies));
+        err = std::max(err, error(mfcc.data() + j * coefficients, reference.mfcc));
+    }
+    CHECK_BELOW(err, 1e-9);
+    
+    return check::result();
+}
@@ -0,0 +1,139 @@
+#include "Check.h"
+#include "Processing.h"
+#include <cstdint>
+#include <fstream>
+
+/* The audio file read by a thread while pFFT() runs gives the same 
+ * frames and spectra, bit for bit, as the file read at once: 
+ * integer PCM WAV files of every bit depth, a data chunk cut short, 
+ * other files (read at once) */
+
+/* Writing v as bytes little-endian bytes */
+static void put(std::string& s, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        s += (char)((v >> (8 * i)) & 0xFF);
+}
+
+/* An integer PCM WAV file of random samples, the data chunk 
+ * cut after cut bytes (0 - whole), returns the frames as AudioFile reads them */
+static std::vector<std::vector<double>> pcm(const std::string& path, int channels, int frames, 
+                                            int bitDepth, size_t cut = 0) {
+    const int bytes = bitDepth / 8;
+    std::vector<std::vector<double>> x(channels);
+    std::string data;
+    unsigned seed = bitDepth;
+    
+    for (int n = 0; n < frames; n++) {
+        for (int i = 0; i < channels; i++) {
+            seed = seed * 1103515245u + 12345u;
+            const uint32_t v = (seed ^ (seed << 13)) >> (32 - bitDepth);
+            put(data, v, bytes);
+            
+            /* 8 bit samples are unsigned, the others signed */
+            const double sample = bitDepth == 8 ? (double)v - 128 
+                    : (double)(int32_t)(v << (32 - bitDepth)) / (1u << (32 - bitDepth));
+            x[i].push_back(sample / std::pow(2.0, bitDepth - 1));
+        }
+    }
+    
+    std::string file = "RIFF";
+    put(file, 36 + data.size(), 4);
+    file += "WAVEfmt ";
+    put(file, 16, 4);
+    put(file, 1, 2);
+    put(file, channels, 2);
+    put(file, 8000, 4);
+    put(file, 8000 * channels * bytes, 4);
+    put(file, channels * bytes, 2);
+    put(file, bitDepth, 2);
+    file += "data";
+    put(file, data.size(), 4);
+    file += cut ? data.substr(0, cut) : data;
+    
+    std::ofstream(path, std::ios::binary).write(file.data(), file.size());
+    return x;
+}
+
+/* The same entries, bit for bit */
+template<typename S>
+static bool equal(const S& a, const S& b) {
+    if (a.size() != b.size())
+        return false;
+    
+    for (size_t j = 0; j < a.size(); j++) {
+        if (a[j].channel != b[j].channel || a[j].frame != b[j].frame 
+                || a[j].bins != b[j].bins || a[j].scaledValues != b[j].scaledValues)
+            return false;
+        for (int k = 0; k < a[j].bins; k++) {
+            if (a[j].values[k].r != b[j].values[k].r || a[j].values[k].i != b[j].values[k].i)
+                return false;
+        }
+    }
+    return true;
+}
+
+/* The file read by the thread against the file read at once, 
+ * frames - the frames expected (none for other files) */
+template<typename T>
+static void compare(const std::string& path, const std::vector<std::vector<double>>& frames) {
+    spectrum::BasicProcessing<T> ahead(512, path.c_str(), spectrum::KISSFFT, true);
+    spectrum::BasicProcessing<T> once(512, path.c_str());
+    
+    /* pFFT() first, while the frames are decoded */
+    ahead.pFFT(20);
+    once.pFFT(20);
+    CHECK(equal(ahead.getpfftValues(), once.getpfftValues()));
+    
+    CHECK(ahead.getSampleRate() == once.getSampleRate());
+    CHECK(ahead.getBitDepth() == once.getBitDepth());
+    CHECK(ahead.getChannels() == once.getChannels());
+    CHECK(ahead.getFrames() == once.getFrames());
+    
+    if (!frames.empty()) {
+        const std::vector<std::vector<T>> decoded = ahead.getFrames();
+        CHECK(decoded.size() == frames.size());
+        for (size_t i = 0; i < decoded.size() && i < frames.size(); i++) {
+            CHECK(decoded[i].size() == frames[i].size());
+            for (size_t n = 0; n < decoded[i].size() && n < frames[i].size(); n++)
+                CHECK(decoded[i][n] == (T)frames[i][n]);
+        }
+    }
+}
+
+int main() {
+    /* Several blocks of the thread, the last one partial */
+    const int frames = 40000;
+    
+    for (int bitDepth : {8, 16, 24, 32}) {
+        const std::string path = "readahead" + std::to_string(bitDepth) + ".wav";
+        const std::vector<std::vector<double>> x = pcm(path, 2, frames, bitDepth);
+        compare<float>(path, x);
+        compare<double>(path, x);
+        
+        /* Every frame up to the end of the data, the last one cut in its middle: 
+         * the thread reads the whole frames, AudioFile::load() stops at the cut */
+        const size_t cut = (size_t)(frames / 3) * 2 * (bitDepth / 8) + 1;
+        std::vector<std::vector<double>> y = pcm(path, 2, frames, bitDepth, cut);
+        for (auto& c : y)
+            c.resize(frames / 3);
+        
+        spectrum::BasicProcessing<double> ahead(512, path.c_str(), spectrum::KISSFFT, true);
+        ahead.pFFT(20);
+        CHECK(ahead.getFramesPerChannel() == frames / 3);
+        CHECK(ahead.getFrames() == y);
+        CHECK(ahead.getpfftValues().size() == (size_t)(2 * std::ceil(frames / 3 / 8000.0 * 20)));
+    }
+    
+    /* Not integer PCM: a 32 bit float WAV file, an AIFF file */
+    std::vector<std::vector<double>> x = {check::noise(frames, 1), check::noise(frames, 2)};
+    compare<float>(check::wav("readahead.float.wav", x, 8000, 32), {});
+    
+    AudioFile<double> aiff;
+    aiff.setAudioBuffer(x);
+    aiff.setSampleRate(8000);
+    aiff.setBitDepth(16);
+    aiff.save("readahead.aiff", AudioFileFormat::Aiff);
+    compare<float>("readahead.aiff", {});
+    
+    return check::result();
+}
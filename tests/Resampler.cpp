@@ -0,0 +1,92 @@
+#include "Check.h"
+#include "Resampler.h"
+
+/* The polyphase resampler: the chunks of a stream give exactly the outputs 
+ * of the whole signal, which are the ones of a sine at the new rate */
+
+/* The whole signal in one call then flush() */
+template<typename T>
+static std::vector<T> resample(spectrum::Resampler<T>& r, const std::vector<T>& x) {
+    std::vector<T> y(r.getSize(x.size()));
+    const int n = r.process(x.data(), x.size(), y.data());
+    CHECK(n + r.getPending() == (int)y.size());
+    CHECK(r.flush(y.data() + n) == (int)y.size() - n);
+    CHECK(r.getPending() == 0);
+    return y;
+}
+
+/* The signal in chunks of 1 to chunk frames */
+template<typename T>
+static std::vector<T> stream(spectrum::Resampler<T>& r, const std::vector<T>& x, int chunk) {
+    std::vector<T> y;
+    unsigned seed = 7;
+    for (size_t i = 0; i < x.size(); ) {
+        seed = seed * 1103515245u + 12345u;
+        const int N = std::min<int>(1 + (seed >> 8) % chunk, x.size() - i);
+        std::vector<T> out(r.getSize(N));
+        
+        const int n = r.process(x.data() + i, N, out.data());
+        CHECK(n <= (int)out.size());
+        y.insert(y.end(), out.begin(), out.begin() + n);
+        i += N;
+    }
+    std::vector<T> out(r.getPending());
+    CHECK(r.flush(out.data()) == (int)out.size());
+    y.insert(y.end(), out.begin(), out.end());
+    return y;
+}
+
+/* The chunks of every size give the same outputs as the single call, 
+ * the same operations on the same frames */
+template<typename T>
+static void compare(spectrum::Resampler<T>& r, const std::vector<double>& signal) {
+    const std::vector<T> x(signal.begin(), signal.end());
+    const std::vector<T> whole = resample(r, x);
+    
+    for (int chunk : {1, 7, 64, 1000}) {
+        const std::vector<T> chunks = stream(r, x, chunk);
+        CHECK(chunks == whole);
+    }
+}
+
+int main() {
+    const std::vector<double> x = check::noise(5000);
+    
+    /* Non-integer ratios (160 / 147, 147 / 160, 2 / 3, 441 / 320 ...), 
+     * then integer ones: 10 ratios, more than the cached filter banks */
+    const std::vector<std::pair<int, int>> ratios = {{44100, 48000}, {48000, 44100}, 
+                                                     {11025, 7350}, {32000, 44100}, 
+                                                     {22050, 16000}, {8000, 44100}, 
+                                                     {8000, 16000}, {16000, 8000}, 
+                                                     {48000, 8000}, {8000, 8000}};
+    
+    /* An object of the first ratio keeps its bank after it left the cache */
+    spectrum::Resampler<double> first(ratios[0].first, ratios[0].second);
+    const std::vector<double> before = resample(first, x);
+    
+    for (auto rates : ratios) {
+        spectrum::Resampler<double> r(rates.first, rates.second);
+        compare(r, x);
+        
+        spectrum::Resampler<float> single(rates.first, rates.second);
+        compare(single, x);
+        
+        /* A sine in the passband, away from the edges of the signal */
+        const double f = 0.3 * std::min(rates.first, rates.second);
+        std::vector<double> sine(4000);
+        for (int n = 0; n < (int)sine.size(); n++)
+            sine[n] = std::sin(2 * check::pi * f * n / rates.first);
+        
+        const std::vector<double> y = resample(r, sine);
+        double err = 0;
+        for (int m = y.size() / 4; m < (int)y.size() * 3 / 4; m++)
+            err = std::max(err, std::abs(y[m] - std::sin(2 * check::pi * f * m / rates.second)));
+        CHECK_BELOW(err, 1e-3);
+    }
+    
+    CHECK(resample(first, x) == before);
+    spectrum::Resampler<double> again(ratios[0].first, ratios[0].second);
+    CHECK(resample(again, x) == before);
+    
+    return check::result();
+}
@@ -0,0 +1,65 @@
+#include "Check.h"
+#include "Ring.h"
+#include <thread>
+
+/* The wait-free ring: the values of a producer thread reach 
+ * a consumer thread in order, none is lost or repeated */
+
+int main() {
+    for (int capacity : {1, 2, 5, 64, 1000})
+        CHECK(spectrum::Ring<float>(capacity).getCapacity() 
+              == (capacity <= 1 ? 1 : 1 << (int)std::ceil(std::log2(capacity))));
+    
+    /* Pushes beyond the capacity are cut, the values wrap around the buffer */
+    spectrum::Ring<long long> ring(8);
+    const long long in[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    long long out[10];
+    CHECK(ring.push(in, 6) == 6 && ring.size() == 6);
+    CHECK(ring.pop(out, 4) == 4 && out[0] == 0 && out[3] == 3);
+    CHECK(ring.push(in + 6, 4) == 4 && ring.size() == 6);
+    CHECK(ring.push(in, 5) == 2 && ring.size() == 8);
+    CHECK(ring.pop(out, 10) == 8);
+    CHECK(out[0] == 4 && out[5] == 9 && out[6] == 0 && out[7] == 1);
+    CHECK(ring.pop(out, 1) == 0 && ring.size() == 0);
+    
+    /* A producer and a consumer of chunks of random sizes */
+    const long long total = 1 << 20;
+    spectrum::Ring<long long> shared(1000);
+    
+    std::thread producer([&]() {
+        std::vector<long long> chunk(300);
+        unsigned seed = 1;
+        for (long long next = 0; next < total; ) {
+            seed = seed * 1103515245u + 12345u;
+            const int n = std::min<long long>(1 + (seed >> 8) % chunk.size(), total - next);
+            for (int i = 0; i < n; i++)
+                chunk[i] = next + i;
+            const int pushed = shared.push(chunk.data(), n);
+            if (pushed == 0)
+                std::this_thread::yield();
+            next += pushed;
+        }
+    });
+    
+    std::vector<long long> chunk(500);
+    unsigned seed = 2;
+    long long expected = 0, errors = 0;
+    while (expected < total) {
+        seed = seed * 1103515245u + 12345u;
+        const int size = shared.size();
+        if (size < 0 || size > shared.getCapacity())
+            errors++;
+        
+        const int n = shared.pop(chunk.data(), 1 + (seed >> 8) % chunk.size());
+        if (n == 0)
+            std::this_thread::yield();
+        for (int i = 0; i < n; i++)
+            errors += chunk[i] != expected++;
+    }
+    producer.join();
+    
+    CHECK(errors == 0);
+    CHECK(shared.size() == 0);
+    
+    return check::result();
+}
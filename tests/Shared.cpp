@@ -0,0 +1,93 @@
+#include "Check.h"
+#include "Processing.h"
+
+/* Objects of several FFT window sizes sharing the frames of one audio file: 
+ * the pFFT() of all of them in one pass gives the entries of separate 
+ * objects, an object replacing the frames no longer shares them */
+
+typedef spectrum::Processing Processing;
+
+/* The same entries, bit for bit */
+static bool equal(const Processing::storage_t& a, const Processing::storage_t& b) {
+    if (a.size() != b.size())
+        return false;
+    
+    for (size_t j = 0; j < a.size(); j++) {
+        if (a[j].channel != b[j].channel || a[j].frame != b[j].frame || a[j].time != b[j].time 
+                || a[j].freqPerBin != b[j].freqPerBin || a[j].firstFreq != b[j].firstFreq 
+                || a[j].bins != b[j].bins || a[j].scaledValues != b[j].scaledValues)
+            return false;
+        
+        for (int k = 0; k < a[j].bins; k++) {
+            if (a[j].values[k].r != b[j].values[k].r || a[j].values[k].i != b[j].values[k].i)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    const int rate = 8000;
+    const std::string path = check::wav("shared.wav", {check::noise(rate + 77, 1), 
+                                                       check::noise(rate + 77, 2)}, rate);
+    
+    /* Window sizes smaller and larger than the hop, and other backends */
+    for (int timeScale : {10, 40}) {
+        Processing source(512, path.c_str());
+        Processing small(256, source), large(1024, source, spectrum::STOCKHAM);
+        Processing odd(1000, source, spectrum::STOCKHAM);
+        Processing::pFFT({&source, &small, &large, &odd}, timeScale);
+        
+        for (Processing* shared : {&source, &small, &large, &odd}) {
+            Processing separate(shared->getNFFT(), path.c_str(), shared->getBackend());
+            separate.pFFT(timeScale);
+            CHECK(equal(shared->getpfftValues(), separate.getpfftValues()));
+        }
+    }
+    
+    /* decimate(), resample(), filter() and ISTFT() of one object: 
+     * it has its own frames, the others keep theirs */
+    for (int method = 0; method < 4; method++) {
+        Processing source(512, path.c_str());
+        Processing a(256, source), b(1024, source);
+        const std::vector<std::vector<float>> frames = source.getFrames();
+        
+        Processing& changed = method % 2 ? a : source;
+        switch (method) {
+        case 0:
+            changed.decimate(2);
+            CHECK(changed.getSampleRate() == rate / 2);
+            break;
+        case 1:
+            changed.resample(11025);
+            CHECK(changed.getSampleRate() == 11025);
+            break;
+        case 2:
+            changed.filter({0.5f, 0.25f});
+            break;
+        case 3:
+            changed.pFFT(40);
+            Processing::storage_t spectra = changed.getpfftValues();
+            for (auto& s : spectra)
+                s.values[1] = kiss_fft_cpx{0, 0};
+            changed.ISTFT(spectra, 2);
+            break;
+        }
+        CHECK(changed.getFrames() != frames);
+        
+        for (Processing* other : {&source, &a, &b}) {
+            if (other == &changed)
+                continue;
+            CHECK(other->getFrames() == frames);
+            CHECK(other->getSampleRate() == rate);
+            CHECK(other->getFramesPerChannel() == rate + 77);
+        }
+        
+        /* An object made from the changed one shares its new frames */
+        Processing c(128, changed);
+        CHECK(c.getFrames() == changed.getFrames());
+        CHECK(c.getSampleRate() == changed.getSampleRate());
+    }
+    
+    return check::result();
+}
@@ -0,0 +1,68 @@
+#include "Check.h"
+#include "Processing.h"
+#include "SlidingDFT.h"
+
+/* The sliding DFT after every sample against the FFT of its window 
+ * computed by the definition, before and after the recomputations */
+
+/* The largest error of the sliding DFT of x over all of its windows */
+template<typename T>
+static double error(int NFFT, int resync, spectrum::Backend backend, const std::vector<double>& x) {
+    spectrum::SlidingDFT<T> sdft(NFFT, resync, backend);
+    CHECK(sdft.isValid() && sdft.getNFFT() == NFFT);
+    
+    const std::vector<T> samples(x.begin(), x.end());
+    std::vector<typename spectrum::SlidingDFT<T>::cpx_t> values(NFFT / 2 + 1);
+    double err = 0;
+    
+    sdft.reset(samples.data());
+    for (int j = 0; j + NFFT <= (int)x.size(); j++) {
+        if (j > 0)
+            sdft.push(samples[j + NFFT - 1]);
+        
+        sdft.values(values.data());
+        const std::vector<double> window(x.begin() + j, x.begin() + j + NFFT);
+        err = std::max(err, check::error(values, check::dftr(window)));
+    }
+    return err;
+}
+
+int main() {
+    const int NFFT = 64;
+    const std::vector<double> x = check::noise(NFFT * 8, 1);
+    
+    /* The recomputation every NFFT samples, every 5 samples, 
+     * and none over the signal (the recurrence only) */
+    for (int resync : {0, 5, 1000}) {
+        CHECK_BELOW(error<double>(NFFT, resync, spectrum::KISSFFT, x), 1e-12);
+        CHECK_BELOW(error<float>(NFFT, resync, spectrum::KISSFFT, x), 1e-4);
+        CHECK_BELOW(error<float>(NFFT, resync, spectrum::STOCKHAM, x), 1e-4);
+    }
+    
+    /* sFFT(): the spectrum of the NFFT frames from every hop-th frame */
+    const int rate = 8000, N = 1000;
+    const std::string path = check::wav("sliding.wav", {check::noise(N, 2), 
+                                                        check::noise(N, 3)}, rate);
+    for (spectrum::Backend backend : {spectrum::KISSFFT, spectrum::STOCKHAM}) {
+        for (int hop : {1, 7, NFFT}) {
+            spectrum::BasicProcessing<double> p(NFFT, path.c_str(), backend);
+            const std::vector<std::vector<double>> frames = p.getFrames();
+            p.sFFT(hop);
+            
+            const spectrum::BasicProcessing<double>::storage_t s = p.getsfftValues();
+            const int windows = (N - NFFT) / hop + 1;
+            CHECK(s.size() == (size_t)(2 * windows));
+            
+            double err = 0;
+            for (const auto& e : s) {
+                CHECK(e.frame % hop == 0 && e.bins == NFFT / 2 + 1);
+                const std::vector<double> window(frames[e.channel].begin() + e.frame, 
+                                                 frames[e.channel].begin() + e.frame + NFFT);
+                err = std::max(err, check::error(e.values, check::dftr(window)));
+            }
+            CHECK_BELOW(err, 1e-12);
+        }
+    }
+    
+    return check::result();
+}
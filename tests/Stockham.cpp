@@ -0,0 +1,41 @@
+#include "Check.h"
+#include "Plan.h"
+#include "Stockham.h"
+
+/* The Stockham backend against the DFT computed by the definition */
+
+static double error(spectrum::Backend backend, int NFFT) {
+    const std::vector<double> x = check::noise(NFFT);
+    std::vector<float> in(x.begin(), x.end());
+    std::vector<kiss_fft_cpx> out(NFFT / 2 + 1);
+    
+    spectrum::Plan plan(NFFT, backend);
+    plan.fftr(in.data(), out.data());
+    
+    return check::error(out, check::dftr(x));
+}
+
+int main() {
+    /* Radix 4 and 2 passes, then 3 and 5 */
+    for (int NFFT : {2, 4, 8, 16, 64, 128, 1024, 4096, 8192, 
+                     6, 10, 30, 360, 1000, 1920, 4800, 2 * 3 * 5 * 3 * 5 * 4}) {
+        CHECK(spectrum::Stockham::isSupported(NFFT));
+        
+        spectrum::Plan plan(NFFT, spectrum::STOCKHAM);
+        CHECK(plan.getBackend() == spectrum::STOCKHAM);
+        CHECK_BELOW(error(spectrum::STOCKHAM, NFFT), 1e-6);
+    }
+    
+    /* Other sizes fall back to kissfft */
+    for (int NFFT : {14, 22, 2 * 101, 2002}) {
+        CHECK(!spectrum::Stockham::isSupported(NFFT));
+        
+        spectrum::Plan plan(NFFT, spectrum::STOCKHAM);
+        CHECK(plan.getBackend() == spectrum::KISSFFT);
+        CHECK_BELOW(error(spectrum::STOCKHAM, NFFT), 1e-6);
+    }
+    CHECK(!spectrum::Stockham::isSupported(0));
+    CHECK(!spectrum::Stockham::isSupported(7));
+    
+    return check::result();
+}
@@ -0,0 +1,157 @@
+#include "Check.h"
+#include "Stream.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/* The real-time analysis against the FFT of the windows of the whole signal, 
+ * the frames pushed by a producer thread while the analysis runs */
+
+typedef spectrum::BasicStream<double> Stream;
+
+/* The spectra emitted, by channel and first frame, 
+ * the callback takes at least delay */
+struct Spectra {
+    std::mutex mutex;
+    std::map<std::pair<int, int>, std::vector<kiss_fft_f64_cpx>> values;
+    std::chrono::microseconds delay{0};
+    int calls = 0;
+    
+    Stream::callback_t callback() {
+        return [this](const Stream::frame_t& f) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            CHECK(f.bins == (int)f.values.size() && f.values.size() == f.scaledValues.size());
+            this->values[std::make_pair(f.channel, f.frame)] = f.values;
+            this->calls++;
+            std::this_thread::sleep_for(this->delay);
+        };
+    }
+};
+
+/* The interleaved frames in chunks of 1 to chunk frames, 
+ * returns the number of frames added */
+static long long push(Stream& stream, const std::vector<std::vector<double>>& x, int chunk) {
+    const int C = x.size(), N = x[0].size();
+    std::vector<double> interleaved(N * C);
+    for (int n = 0; n < N; n++) {
+        for (int c = 0; c < C; c++)
+            interleaved[n * C + c] = x[c][n];
+    }
+    
+    unsigned seed = 5;
+    long long added = 0;
+    for (int i = 0; i < N; ) {
+        seed = seed * 1103515245u + 12345u;
+        const int n = std::min<int>(1 + (seed >> 8) % chunk, N - i);
+        const int k = stream.push(interleaved.data() + i * C, n);
+        CHECK(k == n || stream.getOverflow() != spectrum::BLOCK);
+        added += k;
+        i += n;
+    }
+    stream.stop();
+    return added;
+}
+
+/* Every window of every channel of x was emitted with the spectrum of its frames, 
+ * every - false for the windows emitted only */
+static double error(Spectra& spectra, const std::vector<std::vector<double>>& x, 
+                    int NFFT, int hop, bool every = true) {
+    const int windows = (x[0].size() - NFFT) / hop + 1;
+    spectrum::BasicPlan<double> plan(NFFT);
+    std::vector<kiss_fft_f64_cpx> reference(NFFT / 2 + 1);
+    double err = 0;
+    
+    CHECK(!every || spectra.values.size() == x.size() * windows);
+    for (int c = 0; c < (int)x.size(); c++) {
+        for (int w = 0; w < windows; w++) {
+            auto s = spectra.values.find(std::make_pair(c, w * hop));
+            CHECK(!every || s != spectra.values.end());
+            if (s == spectra.values.end())
+                continue;
+            
+            plan.fftr(x[c].data() + w * hop, reference.data());
+            std::vector<std::complex<double>> r(reference.size());
+            for (size_t k = 0; k < r.size(); k++)
+                r[k] = std::complex<double>(reference[k].r, reference[k].i);
+            err = std::max(err, check::error(s->second, r));
+        }
+    }
+    return err;
+}
+
+int main() {
+    const int NFFT = 256, hop = 64, rate = 8000;
+    const std::vector<std::vector<double>> x = {check::noise(4000, 1), check::noise(4000, 2)};
+    
+    /* FIR filtering of the hops, against the convolution of the whole signal */
+    for (int L : {1, 50, 700}) {
+        const std::vector<double> taps = check::noise(L, 3);
+        std::vector<std::vector<double>> y(x.size(), std::vector<double>(x[0].size()));
+        for (size_t c = 0; c < x.size(); c++) {
+            for (int n = 0; n < (int)x[c].size(); n++) {
+                for (int k = 0; k < L && k <= n; k++)
+                    y[c][n] += taps[k] * x[c][n - k];
+            }
+        }
+        
+        Spectra spectra;
+        Stream stream(NFFT, hop, rate, 2, spectra.callback(), spectrum::KISSFFT, 16, 0, 
+                      spectrum::BLOCK);
+        stream.setFilter(taps);
+        push(stream, x, 300);
+        CHECK_BELOW(error(spectra, y, NFFT, hop), 1e-9);
+    }
+    
+    /* BLOCK: a ring smaller than a window, the producer waits for room, 
+     * every window is emitted */
+    {
+        Spectra spectra;
+        Stream stream(NFFT, hop, rate, 2, spectra.callback(), spectrum::KISSFFT, 16, 100, 
+                      spectrum::BLOCK);
+        CHECK(push(stream, x, 1000) == (long long)x[0].size());
+        CHECK(stream.getDropped() == 0);
+        CHECK_BELOW(error(spectra, x, NFFT, hop), 1e-12);
+    }
+    
+    /* DROP: a slow analysis, the frames that do not fit are dropped, 
+     * the frames added are analyzed as a stream of their own */
+    {
+        Spectra spectra;
+        spectra.delay = std::chrono::microseconds(200);
+        Stream stream(NFFT, hop, rate, 2, spectra.callback(), spectrum::KISSFFT, 16, 512, 
+                      spectrum::DROP);
+        const long long added = push(stream, x, 1000);
+        
+        CHECK(stream.getDropped() > 0);
+        CHECK(added + stream.getDropped() == (long long)x[0].size());
+        
+        const int windows = added < NFFT ? 0 : (added / hop) - NFFT / hop + 1;
+        CHECK(spectra.calls == 2 * windows);
+        for (int w = 0; w < windows; w++) {
+            CHECK(spectra.values.count(std::make_pair(0, w * hop)) == 1);
+            CHECK(spectra.values.count(std::make_pair(1, w * hop)) == 1);
+        }
+    }
+    
+    /* COALESCE: a slow analysis skips the windows it cannot catch up with, 
+     * the windows emitted keep their spectrum, each one has its latency */
+    {
+        Spectra spectra;
+        spectra.delay = std::chrono::microseconds(200);
+        Stream stream(NFFT, hop, rate, 2, spectra.callback(), spectrum::KISSFFT, 16, 
+                      (int)x[0].size(), spectrum::COALESCE);
+        CHECK(push(stream, x, 1000) == (long long)x[0].size());
+        
+        const int windows = ((int)x[0].size() - NFFT) / hop + 1;
+        CHECK(stream.getDropped() == 0);
+        CHECK(stream.getCoalesced() > 0);
+        CHECK(spectra.calls % 2 == 0 && spectra.calls / 2 + stream.getCoalesced() == windows);
+        CHECK_BELOW(error(spectra, x, NFFT, hop, false), 1e-12);
+        
+        CHECK(stream.getLatency().getCount() == spectra.calls);
+        CHECK(stream.getLatency().getPercentile(50) <= stream.getLatency().getMax());
+    }
+    
+    return check::result();
+}
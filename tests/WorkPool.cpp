@@ -0,0 +1,65 @@
+#include "Check.h"
+#include "WorkPool.h"
+
+/* The work-stealing pool: every task submitted runs once, 
+ * wait() returns only when the tasks of every thread are done, 
+ * tasks submitted by several threads and by the tasks themselves */
+
+int main() {
+    for (int threads : {1, 2, 4}) {
+        spectrum::WorkPool pool(threads);
+        CHECK(pool.getThreads() == threads);
+        
+        /* Tasks of very different durations */
+        std::atomic<int> runs(0);
+        for (int t = 0; t < 200; t++) {
+            pool.submit([&runs, t]() {
+                if (t % 50 == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                runs++;
+            });
+        }
+        pool.wait();
+        CHECK(runs == 200);
+        
+        /* Several threads submitting and waiting: once wait() returns, 
+         * the tasks of the thread are done, whatever the others do */
+        const int submitters = 4, tasks = 2000;
+        std::vector<std::atomic<int>> done(submitters);
+        std::atomic<int> late(0);
+        std::vector<std::thread> others;
+        
+        for (int s = 0; s < submitters; s++) {
+            done[s] = 0;
+            others.push_back(std::thread([&, s]() {
+                for (int round = 0; round < 10; round++) {
+                    for (int t = 0; t < tasks / 10; t++)
+                        pool.submit([&done, s]() { done[s]++; });
+                    pool.wait();
+                    
+                    if (done[s] != (round + 1) * tasks / 10)
+                        late++;
+                }
+            }));
+        }
+        for (std::thread& t : others)
+            t.join();
+        
+        CHECK(late == 0);
+        for (int s = 0; s < submitters; s++)
+            CHECK(done[s] == tasks);
+        
+        /* Tasks submitting tasks */
+        std::atomic<int> nested(0);
+        for (int t = 0; t < 50; t++) {
+            pool.submit([&pool, &nested]() {
+                nested++;
+                pool.submit([&nested]() { nested++; });
+            });
+        }
+        pool.wait();
+        CHECK(nested == 100);
+    }
+    
+    return check::result();
+}
@@ -0,0 +1,89 @@
+#include "Check.h"
+#include "Processing.h"
+#include "Zoom.h"
+
+/* The zoom FFT against the bins of the band of one long FFT 
+ * of the same frames zero padded, for signals of the band: 
+ * tones of the band under a Hann envelope, so that nothing 
+ * of the signal is out of the band and of the passband of the filter, 
+ * they differ by the ripple of the passband (about -74 dB) */
+
+/* N frames of tones of the band [fmin, fmax] */
+static std::vector<double> tones(int N, float fmin, float fmax, int sampleRate) {
+    std::vector<double> x(N);
+    const std::vector<double> random = check::noise(16, 7);
+    
+    for (int t = 0; t < 8; t++) {
+        const double f = fmin + (fmax - fmin) * (0.1 + 0.8 * t / 7.0);
+        for (int n = 0; n < N; n++) {
+            const double w = 0.5 - 0.5 * std::cos(2 * check::pi * n / N);
+            x[n] += w * random[t] * std::cos(2 * check::pi * f * n / sampleRate + 3 * random[t + 8]);
+        }
+    }
+    return x;
+}
+
+/* The bins of the zoom FFT against the FFT of getInputSize() frames, 
+ * its bins k * freqPerBin from the first frequency of the band */
+template<typename V>
+static double error(const V& values, int size, float firstFreq, float freqPerBin, 
+                    const std::vector<double>& x, int NFFT) {
+    std::vector<double> padded(x.begin(), x.begin() + std::min((int)x.size(), NFFT));
+    padded.resize(NFFT);
+    
+    spectrum::BasicPlan<double> plan(NFFT);
+    std::vector<kiss_fft_f64_cpx> X(NFFT / 2 + 1);
+    plan.fftr(padded.data(), X.data());
+    
+    const int first = std::lround(firstFreq / freqPerBin);
+    CHECK(std::abs(firstFreq - first * freqPerBin) < 1e-3 * freqPerBin);
+    CHECK(first >= 0 && first + size <= NFFT / 2 + 1);
+    
+    std::vector<std::complex<double>> reference(size);
+    for (int k = 0; k < size; k++)
+        reference[k] = std::complex<double>(X[first + k].r, X[first + k].i);
+    return check::error(values, reference);
+}
+
+int main() {
+    const int rate = 8000;
+    
+    /* The decimation of a narrow band, then a wide band (no decimation), 
+     * the signal shorter than the input of the zoom, then longer */
+    for (auto band : std::vector<std::pair<float, float>>{{1000, 1200}, {3000, 3500}, 
+                                                         {500, 3500}}) {
+        spectrum::Zoom<double> zoom(band.first, band.second, 1, rate);
+        CHECK(zoom.isValid());
+        CHECK(zoom.getFreqPerBin() <= 1);
+        CHECK(zoom.getFirstFreq() >= band.first);
+        CHECK(zoom.getFirstFreq() + (zoom.getSize() - 1) * zoom.getFreqPerBin() <= band.second);
+        
+        const int NFFT = zoom.getInputSize();
+        for (int N : {NFFT * 3 / 4, NFFT}) {
+            const std::vector<double> x = tones(N, band.first, band.second, rate);
+            std::vector<kiss_fft_f64_cpx> values(zoom.getSize());
+            zoom.transform(x.data(), N, values.data());
+            
+            CHECK_BELOW(error(values, zoom.getSize(), zoom.getFirstFreq(), 
+                              zoom.getFreqPerBin(), x, NFFT), 1e-3);
+        }
+    }
+    
+    /* zoomFFT(): each channel from its beginning */
+    const std::string path = check::wav("zoom.wav", {tones(6000, 1000, 1200, rate), 
+                                                     tones(6000, 1000, 1200, rate)}, rate);
+    spectrum::BasicProcessing<double> p(512, path.c_str());
+    const std::vector<std::vector<double>> frames = p.getFrames();
+    const spectrum::BasicProcessing<double>::storage_t s = p.zoomFFT(1000, 1200, 1);
+    
+    spectrum::Zoom<double> zoom(1000, 1200, 1, rate);
+    CHECK(s.size() == 2);
+    for (const auto& e : s) {
+        CHECK(e.bins == zoom.getSize() && e.values.size() == (size_t)e.bins);
+        CHECK(e.firstFreq == zoom.getFirstFreq() && e.freqPerBin == zoom.getFreqPerBin());
+        CHECK_BELOW(error(e.values, e.bins, e.firstFreq, e.freqPerBin, 
+                          frames[e.channel], zoom.getInputSize()), 1e-3);
+    }
+    
+    return check::result();
+}